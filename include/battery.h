@@ -0,0 +1,47 @@
+// Battery Voltage Monitor
+#pragma once
+
+#include <stdint.h>
+
+/***********************************************************************************************************************
+ *
+ *  On the ATmega32u4 the ADC is left auto-triggered by the Timer0 overflow (~976 Hz, the same tick that drives
+ *  millis()), and its interrupt feeds every conversion into an integer IIR filter, so the loop never waits on
+ *  analogRead() nor touches floats. Filtered readings are raw ADC counts scaled by 2^BATTERY_FILTER_SHIFT and are
+ *  compared against thresholds built at compile time with battery_counts(). Other targets sample through
+ *  battery_sample() from the loop into the same filter.
+ *
+ **********************************************************************************************************************/
+
+// Battery Voltage Divider
+constexpr float BATTERY_R1 = 30000.0;
+constexpr float BATTERY_R2 = 7500.0;
+constexpr float ADC_REFERENCE = 5.0;
+
+// Filter Time Constant (2^BATTERY_FILTER_SHIFT Samples)
+const uint8_t BATTERY_FILTER_SHIFT = 5;
+
+// Converts a Battery Voltage to Filtered ADC Counts
+constexpr uint16_t battery_counts(float volts)
+{
+  return (uint16_t)(volts * BATTERY_R2 / (BATTERY_R1 + BATTERY_R2) / ADC_REFERENCE * 1024.0 * (1 << BATTERY_FILTER_SHIFT) +
+                    0.5);
+}
+
+// Battery Voltage at the ADC Full Scale (mV)
+constexpr uint32_t BATTERY_FULL_SCALE_MV = (uint32_t)(ADC_REFERENCE * 1000.0 * (BATTERY_R1 + BATTERY_R2) / BATTERY_R2 + 0.5);
+
+// Seeds the Filter with One Reading and Starts the Background Sampling
+void battery_begin(uint8_t pin);
+
+// Feeds One Reading into the Filter Where No Background Sampling Exists (No-op on the ATmega32u4)
+void battery_sample(void);
+
+// Filtered Battery Reading (Counts Scaled by 2^BATTERY_FILTER_SHIFT)
+uint16_t battery_reading(void);
+
+// Converts a Filtered Reading to Millivolts
+inline uint16_t battery_millivolts(uint16_t reading)
+{
+  return (uint16_t)(((uint32_t)reading * BATTERY_FULL_SCALE_MV) >> (10 + BATTERY_FILTER_SHIFT));
+}
@@ -0,0 +1,76 @@
+// Battery State of Charge Estimator
+#pragma once
+
+#include <stdint.h>
+#include "mixer.h"
+#include "battery.h"
+
+/***********************************************************************************************************************
+ *
+ *  Tells how much charge is left in the pack, and for how many minutes of driving, from the battery reading alone. The
+ *  reading sags under the motor current, so the pack is modelled as an open circuit voltage behind an internal
+ *  resistance, with the total duty sent to the wheels standing for the current drawn:
+ *      reading = open circuit voltage - resistance * load
+ *  Both are learned while the robot runs by a least mean squares step on every battery task run, in integers: readings
+ *  at rest pull the open circuit voltage, readings under load pull the resistance, each in proportion to the load.
+ *
+ *  The open circuit voltage maps to a state of charge through a flash table of the resting voltage of the 2S LiPo pack,
+ *  indexed by voltage, interpolated between entries and built at compile time from the discharge curve of one cell.
+ *
+ *  The drop of the state of charge is measured over every SOC_WINDOW_MS of driving (load of at least SOC_DRIVING_LOAD,
+ *  time at rest costs next to nothing and is left out) and smoothed from one window to the next. The failsafe trips on
+ *  the first sag below the cutoff, so the charge it leaves is that of the cutoff plus the sag at the peak load of the
+ *  last window. The minutes left are the charge above it over the drop: driving time until the battery failsafe stops
+ *  the robot, SOC_MINUTES_UNKNOWN until the first window of driving ends.
+ *
+ **********************************************************************************************************************/
+
+// Pack Cells (in Series)
+const uint8_t SOC_CELLS = 2;
+
+// Charge Table (Pack Millivolts of the Lowest Entry, Step per Entry)
+const uint16_t SOC_TABLE_MV = 6420;
+const uint8_t SOC_TABLE_SIZE = 32;
+const uint8_t SOC_TABLE_STEP_SHIFT = 6;
+
+// Load Smoothing (2^SOC_LOAD_FILTER_SHIFT Control Task Runs, as Long as the Battery Filter) and Full Load Scale (255 is
+// All Four Wheels at Full Duty)
+const uint8_t SOC_LOAD_FILTER_SHIFT = 4;
+const uint8_t SOC_LOAD_FULL_SHIFT = 8;
+
+// Internal Resistance, as the Sag at Full Load (Millivolts)
+const uint16_t SOC_RESISTANCE_START_MV = 400;
+const uint16_t SOC_RESISTANCE_MAX_MV = 2000;
+
+// Learning Rate of the Model (1/2^SOC_GAIN_SHIFT of the Error per Battery Task Run)
+const uint8_t SOC_GAIN_SHIFT = 4;
+
+// Driving Time per Drain Measurement (Milliseconds) and Least Load Counted as Driving
+const uint16_t SOC_WINDOW_MS = 60000;
+const uint8_t SOC_DRIVING_LOAD = 16;
+
+// Minutes Left Not Known Yet
+const uint8_t SOC_MINUTES_UNKNOWN = 0xFF;
+
+// State of Charge Estimate
+typedef struct
+{
+  uint16_t open_circuit_mv;
+  uint16_t resistance_mv;
+  uint8_t load;
+  uint16_t charge;
+  uint8_t percent;
+  uint8_t minutes;
+} soc_stats;
+
+// Starts the Estimator From a Filtered Battery Reading at Rest and the Reading of the Battery Failsafe
+void soc_begin(uint16_t reading, uint16_t cutoff_reading);
+
+// Feeds the Wheel Duties Sent to the Motors (From the Control Task, REST_COMMAND While Stopped)
+void soc_load(const drive_command &drive);
+
+// Feeds a Filtered Battery Reading (From the Battery Task)
+void soc_update(uint16_t reading, unsigned long now);
+
+// Reads the Estimate (charge in 1/256 Percent)
+const soc_stats &soc_statistics(void);
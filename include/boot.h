@@ -0,0 +1,73 @@
+// Boot Supervision
+#pragma once
+
+#include <stdint.h>
+
+/***********************************************************************************************************************
+ *
+ *  Guards the robot from reset on. The reset flags are saved from MCUSR before the C runtime starts, and a watchdog
+ *  left running by a watchdog reset is stopped there too, so a slow setup() can never be reset again halfway. Then
+ *  boot_begin() arms the hardware watchdog with BOOT_WATCHDOG_TIMEOUT and loop() pets it on every pass: a hung task or
+ *  bus resets the robot within the timeout, the motor pins falling back to inputs (the L298P stopped) meanwhile. The
+ *  watchdog is no longer petted once something else re-arms it with another timeout, which is how the USB core of the
+ *  Leonardo jumps to the bootloader for an upload.
+ *
+ *  The radio is brought up in a bounded number of attempts instead of waiting for it forever, so setup() always ends
+ *  in a known time and the robot boots without a radio, stopped, retrying it later.
+ *
+ *  Boot milestones are stamped in milliseconds from the start of the sketch (millis() at each of them), up to the first
+ *  packet accepted from the controller. A bootloader that clears MCUSR before starting the sketch leaves the reset
+ *  reason as BOOT_RESET_UNKNOWN.
+ *
+ **********************************************************************************************************************/
+
+// Reset Reasons (the MCUSR Flags, More Than One May Be Set)
+const uint8_t BOOT_RESET_UNKNOWN = 0x00;
+const uint8_t BOOT_RESET_POWER_ON = 0x01;
+const uint8_t BOOT_RESET_EXTERNAL = 0x02;
+const uint8_t BOOT_RESET_BROWNOUT = 0x04;
+const uint8_t BOOT_RESET_WATCHDOG = 0x08;
+const uint8_t BOOT_RESET_JTAG = 0x10;
+
+// Watchdog Timeout (Milliseconds, One of the Hardware Steps)
+const uint16_t BOOT_WATCHDOG_TIMEOUT = 250;
+
+// Boot Milestones
+enum boot_stage
+{
+  BOOT_SETUP = 0,
+  BOOT_MOTORS,
+  BOOT_RADIO,
+  BOOT_READY,
+  BOOT_FIRST_PACKET,
+  NUMBER_BOOT_STAGES
+};
+
+// Milestone Not Reached Yet
+const uint16_t BOOT_NOT_REACHED = 0xFFFF;
+
+// Boot Statistics (Milestones in Milliseconds From the Start of the Sketch)
+typedef struct
+{
+  uint8_t reset_reason;
+  uint8_t radio_attempts;
+  uint16_t stage_ms[NUMBER_BOOT_STAGES];
+} boot_stats;
+
+// Takes the Saved Reset Reason, Stamps BOOT_SETUP and Arms the Watchdog
+void boot_begin(void);
+
+// Restarts the Watchdog Timeout
+void boot_watchdog_pet(void);
+
+// Stamps a Milestone the First Time it is Reached, Returns True Only Then
+bool boot_mark(uint8_t stage);
+
+// Tries to Bring the Radio Up at Most attempts Times (Petting the Watchdog), Stamps BOOT_RADIO Once Up
+bool boot_radio(uint8_t attempts);
+
+// Reads the Boot Statistics
+const boot_stats &boot_statistics(void);
+
+// Prints the Reset Reason and Milestones on the Serial Port
+void boot_report(void);
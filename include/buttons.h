@@ -0,0 +1,47 @@
+// Controller Buttons Debouncer
+#pragma once
+
+#include <stdint.h>
+#include "controller.h"
+
+/***********************************************************************************************************************
+ *
+ *  All buttons are debounced together as bits of one byte with a 2-bit vertical counter: a button only changes state
+ *  once its reading differed from the debounced state for four consecutive ticks of DEBOUNCE_TIME / 4, which takes a
+ *  handful of logic instructions for every button at once. State changes come out as press and release masks that
+ *  are dispatched through a table with one action pair per button.
+ *
+ **********************************************************************************************************************/
+
+// Buttons Count
+const uint8_t NUMBER_BUTTONS = 6;
+
+// Button Debounce
+const uint8_t DEBOUNCE_TIME = 100;
+const uint8_t DEBOUNCE_TICK = DEBOUNCE_TIME / 4;
+
+// Press and Release Masks (Bit N-1 is Button N)
+typedef struct
+{
+  uint8_t pressed;
+  uint8_t released;
+} button_edges;
+
+// Actions Run on Each Edge of a Button (NULL for None)
+typedef struct
+{
+  void (*pressed)(void);
+  void (*released)(void);
+} button_action;
+
+// Packs the Controller Buttons Readings into One Byte
+uint8_t buttons_pack(const controller_variables &controller);
+
+// Debounces the Packed Readings, Returns the Buttons That Changed State
+button_edges buttons_update(uint8_t readings, unsigned long now);
+
+// Debounced Buttons State
+uint8_t buttons_state(void);
+
+// Runs the Actions of the Edges from a Table Stored in Flash
+void buttons_dispatch(const button_edges &edges, const button_action *actions);
@@ -0,0 +1,30 @@
+// Controller Stream Capture
+#pragma once
+
+#include <stdint.h>
+#include "controller.h"
+#include "radio_link.h"
+
+/***********************************************************************************************************************
+ *
+ *  With CAPTURE defined in main.cpp every accepted controller packet is written to the serial port as one CSV line,
+ *  after a header written at start. Logging the port to a file gives a capture the host replay driver
+ *  (native/replay) feeds back through loop(). Captures can also be written by hand, one line per packet:
+ *
+ *    # omnirobot capture v1
+ *    time_us,sequence,button1,button2,button3,button4,button5,button6,X1,Y1,X2,Y2,slider1,slider2,battery
+ *
+ *  time_us is when the packet left the radio FIFO, sequence is the controller frame sequence number, buttons are 0 or 1
+ *  and the analog fields are the raw 10-bit readings. battery is the raw battery ADC reading at the time.
+ *
+ **********************************************************************************************************************/
+
+// Capture Format Header Lines
+#define CAPTURE_MAGIC "# omnirobot capture v1"
+#define CAPTURE_COLUMNS "time_us,sequence,button1,button2,button3,button4,button5,button6,X1,Y1,X2,Y2,slider1,slider2,battery"
+
+// Writes the Capture Header
+void capture_begin(void);
+
+// Writes One Packet
+void capture_packet(const controller_variables &controller, const radio_link_packet &packet, uint16_t battery);
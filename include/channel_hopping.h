@@ -0,0 +1,85 @@
+// Radio Channel Hopping Plan
+#pragma once
+
+#include <stdint.h>
+
+/***********************************************************************************************************************
+ *
+ *  Built only with -D RADIO_HOPPING, on the robot and the controller alike. At boot the robot samples the received
+ *  power detector of every channel in the survey range and keeps the HOP_CHANNELS quietest ones, at least two channels
+ *  apart, as its hop plan. Both ends start on the fixed rendezvous channel; the robot appends the plan (hop_plan) to the
+ *  ack payload of every packet there, and both ends move to the plan once the controller sequence number reaches
+ *  apply_sequence.
+ *
+ *  While hopping, the channel is a function of the sequence number of the packet, so the two ends stay in step without
+ *  sharing a clock: packet q goes out on active channel (q >> HOP_DWELL_SHIFT) % active count. The robot follows the
+ *  sequence numbers it receives and, when packets stop, keeps advancing at the measured packet interval. Losses are
+ *  counted per channel; every HOP_EVALUATE_PACKETS packets the channels losing more than a quarter of their packets are
+ *  dropped from the active mask (keeping at least HOP_MIN_CHANNELS), and the new mask is announced through the ack
+ *  payloads with its own apply_sequence. Without any packet for HOP_RESYNC_TIMEOUT both ends go back to the rendezvous
+ *  channel and the full plan.
+ *
+ *  This module holds the plan and the statistics only; radio_link tunes the radio to the channels it returns.
+ *
+ **********************************************************************************************************************/
+
+// Hop Plan Size
+const uint8_t HOP_CHANNELS = 8;
+const uint8_t HOP_MIN_CHANNELS = 3;
+
+// Channel Both Ends Meet on at Start and After Losing Each Other (RF24 Default)
+const uint8_t HOP_RENDEZVOUS_CHANNEL = 76;
+
+// Surveyed Channels (2.402 GHz to 2.482 GHz) and Survey Length
+const uint8_t HOP_SURVEY_FIRST = 2;
+const uint8_t HOP_SURVEY_COUNT = 81;
+const uint8_t HOP_SURVEY_PASSES = 4;
+const uint16_t HOP_SURVEY_DWELL_US = 200;
+
+// Packets Sent on a Channel Before Hopping (2^HOP_DWELL_SHIFT)
+const uint8_t HOP_DWELL_SHIFT = 2;
+
+// Packets Between the Plan Announcement and its Use
+const uint8_t HOP_ANNOUNCE_LEAD = 16;
+
+// Packets Between Two Channel Loss Evaluations
+const uint16_t HOP_EVALUATE_PACKETS = 256;
+
+// Silence After Which Both Ends Go Back to the Rendezvous Channel
+const uint32_t HOP_RESYNC_TIMEOUT_US = 100000;
+
+// Plan Announcement (Appended to the Ack Payload)
+typedef struct __attribute__((packed))
+{
+  uint8_t channels[HOP_CHANNELS];
+  uint8_t mask;
+  uint8_t apply_sequence;
+} hop_plan;
+
+// Hopping Statistics
+typedef struct
+{
+  uint8_t channel;
+  bool hopping;
+  uint8_t mask;
+  uint16_t heard[HOP_CHANNELS];
+  uint16_t missed[HOP_CHANNELS];
+  uint16_t resyncs;
+  uint16_t drops;
+  uint16_t coasts;
+} hop_stats;
+
+// Builds the Plan from the Survey (Busy Samples per Channel From HOP_SURVEY_FIRST) and Meets at the Rendezvous
+void hopping_begin(const uint8_t *busy);
+
+// Records a Valid Packet, Returns the Channel to Listen on for the Next One
+uint8_t hopping_received(uint8_t sequence, uint32_t now);
+
+// Advances Through the Plan While Packets are Missing, Returns the Channel to Listen on
+uint8_t hopping_update(uint32_t now);
+
+// Plan to Append to the Ack Payloads, if One Has to be Announced
+bool hopping_announcement(hop_plan &plan);
+
+// Hopping Statistics
+const hop_stats &hopping_statistics(void);
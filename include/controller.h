@@ -0,0 +1,21 @@
+// Controller Packet Definition
+#pragma once
+
+#include <stdint.h>
+
+// Variables structure
+typedef struct
+{
+  uint8_t button1_reading;
+  uint8_t button2_reading;
+  uint8_t button3_reading;
+  uint8_t button4_reading;
+  uint8_t button5_reading;
+  uint8_t button6_reading;
+  uint16_t X1axis_reading;
+  uint16_t Y1axis_reading;
+  uint16_t X2axis_reading;
+  uint16_t Y2axis_reading;
+  uint16_t slider1_reading;
+  uint16_t slider2_reading;
+} controller_variables;
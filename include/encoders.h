@@ -0,0 +1,45 @@
+// Wheel Encoders
+#pragma once
+
+#include <stdint.h>
+#include "mixer.h"
+
+/***********************************************************************************************************************
+ *
+ *  One single channel encoder per wheel, counted on both edges by an external interrupt. The counts carry no direction:
+ *  the speed controller takes it from the direction the wheel is driven, which the ramps only reverse after the wheel
+ *  coasted to rest. Wheels whose pin is ENCODER_NONE, or a pin without an external interrupt, have no encoder and are
+ *  left open loop.
+ *
+ *  Pins are set at build time with -D ENCODER_PIN_FRONT_LEFT=<pin> and so on. The Leonardo has external interrupts on
+ *  pins 0, 1, 2, 3 and 7, but the L298P shield takes 3 and 7 for direction pins and RADIO_IRQ_PIN may take 2, so
+ *  encoding all four wheels needs a direction jumper moved off pin 3 or 7 (to A4 or A5, built with -D MOTOR_PIN_DIRA=A4
+ *  or -D MOTOR_PIN_DIRC=A4, see motor_driver.h). An encoder pin on a direction pin or on RADIO_IRQ_PIN fails the build.
+ *
+ **********************************************************************************************************************/
+
+// No Encoder on the Wheel
+const uint8_t ENCODER_NONE = 0xFF;
+
+// Encoder Pins
+#ifndef ENCODER_PIN_FRONT_LEFT
+#define ENCODER_PIN_FRONT_LEFT ENCODER_NONE
+#endif
+#ifndef ENCODER_PIN_FRONT_RIGHT
+#define ENCODER_PIN_FRONT_RIGHT ENCODER_NONE
+#endif
+#ifndef ENCODER_PIN_BACK_LEFT
+#define ENCODER_PIN_BACK_LEFT ENCODER_NONE
+#endif
+#ifndef ENCODER_PIN_BACK_RIGHT
+#define ENCODER_PIN_BACK_RIGHT ENCODER_NONE
+#endif
+
+// Attaches the Encoder Interrupts, Returns a Mask of the Wheels With an Encoder (Bit N is Wheel N)
+uint8_t encoders_begin(void);
+
+// Takes the Edges Counted on Each Wheel Since the Last Call
+void encoders_read(uint8_t edges[NUMBER_WHEELS]);
+
+// Drops the Edges Counted So Far
+void encoders_clear(void);
@@ -0,0 +1,65 @@
+// Command Failsafe Tiers
+#pragma once
+
+#include <stdint.h>
+
+/***********************************************************************************************************************
+ *
+ *  Decides what the wheels do as packets stop coming, in three tiers counted from the arrival of the newest packet:
+ *
+ *    FAILSAFE_DRIVE  the last command keeps driving for FAILSAFE_HOLD_PACKETS packet intervals (clamped between
+ *                    FAILSAFE_HOLD_MIN_US and FAILSAFE_HOLD_MAX_US), hiding single lost packets
+ *    FAILSAFE_DECEL  the wheels are sent to rest through their deceleration ramps
+ *    FAILSAFE_STOP   from FAILSAFE_STOP_US on the motors are stopped outright
+ *
+ *  Time runs from the moment the radio took the packet out of its FIFO, not from when the loop got to read it, and only
+ *  a packet newer than the last one accepted (by sequence number) restarts it, so repeated or late packets can never
+ *  keep an old command alive: up to FAILSAFE_LATE_PACKETS behind the newest a packet is taken as repeated or late and
+ *  rejected, further back than that as a controller that restarted its sequence, followed from there on. The packet
+ *  interval is measured from the sequence numbers too. Once stopped, any packet is accepted.
+ *
+ **********************************************************************************************************************/
+
+// Failsafe Tiers
+enum failsafe_tier
+{
+  FAILSAFE_DRIVE = 0,
+  FAILSAFE_DECEL,
+  FAILSAFE_STOP
+};
+
+// Command Hold (Packets, and Limits in Microseconds)
+const uint8_t FAILSAFE_HOLD_PACKETS = 3;
+const uint32_t FAILSAFE_HOLD_MIN_US = 20000;
+const uint32_t FAILSAFE_HOLD_MAX_US = 80000;
+
+// Sequence Window Behind the Newest Packet Rejected as Repeated or Late, Larger Advances (Modulo 256) Go Back Further
+const uint8_t FAILSAFE_LATE_PACKETS = 16;
+const uint8_t FAILSAFE_ADVANCE_MAX = 127;
+
+// Hard Stop After the Newest Packet
+const uint32_t FAILSAFE_STOP_US = 300000;
+
+// Failsafe Statistics
+typedef struct
+{
+  uint8_t tier;
+  uint32_t interval_us;
+  uint16_t holds;
+  uint16_t decels;
+  uint16_t stops;
+  uint16_t rejected;
+  uint16_t resyncs;
+} failsafe_stats;
+
+// Starts Stopped Until the First Packet
+void failsafe_begin(void);
+
+// Offers a Received Packet, False if it is Not Newer Than the Last One Accepted
+bool failsafe_packet(uint8_t sequence, uint32_t received_at);
+
+// Tier for the Current Time
+uint8_t failsafe_update(uint32_t now);
+
+// Failsafe Statistics
+const failsafe_stats &failsafe_statistics(void);
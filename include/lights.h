@@ -0,0 +1,33 @@
+// Robot Lights Frame Renderer
+#pragma once
+
+#include <Adafruit_NeoPixel.h>
+
+/***********************************************************************************************************************
+ *
+ *  Every combination of front light, back light, blinkers and blink phase maps to one precomputed frame per strip,
+ *  stored in flash as 2 bits per pixel (off, white, red, orange). Rendering only looks up the frame for the current
+ *  state and pushes a strip when its frame actually changed, no more often than LIGHTS_MAX_REFRESH_HZ, since every
+ *  WS2812 show() blocks the interrupts for the whole strip transfer.
+ *
+ **********************************************************************************************************************/
+
+// Maximum Strip Refresh Rate
+#ifndef LIGHTS_MAX_REFRESH_HZ
+#define LIGHTS_MAX_REFRESH_HZ 50
+#endif
+const uint16_t LIGHTS_REFRESH_INTERVAL = 1000 / LIGHTS_MAX_REFRESH_HZ;
+
+// Lights State Bits
+const uint8_t LIGHT_FRONT = 0x01;
+const uint8_t LIGHT_BACK = 0x02;
+const uint8_t LIGHT_BLINK_RIGHT = 0x04;
+const uint8_t LIGHT_BLINK_LEFT = 0x08;
+const uint8_t LIGHT_BLINK_PHASE = 0x10;
+const uint8_t NUMBER_LIGHT_STATES = 0x20;
+
+// Binds the Renderer to the Strips (Both Must Have Been Cleared and Shown Already)
+void lights_begin(Adafruit_NeoPixel *front, Adafruit_NeoPixel *back);
+
+// Renders the Lights State, Returns True if Any Strip Was Pushed
+bool lights_render(uint8_t state, unsigned long now);
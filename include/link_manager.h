@@ -0,0 +1,81 @@
+// Radio Link Profile Manager
+#pragma once
+
+#include <stdint.h>
+
+/***********************************************************************************************************************
+ *
+ *  Built only with -D RADIO_ADAPTIVE_RATE, on the robot and the controller alike. Both ends start on the robust profile
+ *  (250 kbps, maximum power). Over windows of LINK_WINDOW_PACKETS packets the robot measures the packet loss (sequence
+ *  gaps), the retries the controller needed (reported in the frames) and how often the received power detector saw a
+ *  strong signal (above -64 dBm). Two clean, strong windows in a row step to the next faster and quieter profile; one
+ *  lossy or retry-heavy window steps back, and a profile that failed right after being reached has to wait twice as
+ *  many clean windows before it is tried again.
+ *
+ *  Changes are a handshake: the robot puts the new profile and the sequence number it applies from in every telemetry
+ *  ack, and both ends switch when the controller sequence reaches it. An end that hears nothing for
+ *  LINK_FALLBACK_TIMEOUT_US (the controller: LINK_FALLBACK_FAILURES unacknowledged packets in a row) drops straight to
+ *  the robust profile on its own, which is where the other end ends up too once the link is lost.
+ *
+ **********************************************************************************************************************/
+
+// Link Profiles (Robust First)
+typedef struct
+{
+  uint8_t data_rate;
+  uint8_t pa_level;
+} link_profile;
+const uint8_t LINK_PROFILES = 4;
+const uint8_t LINK_ROBUST = 0;
+
+// Profile Reported by Robots Not Built with RADIO_ADAPTIVE_RATE
+const uint8_t LINK_FIXED = 0xFF;
+
+// Packets per Evaluation Window
+const uint8_t LINK_WINDOW_PACKETS = 64;
+
+// Step Back Above Either Limit Within a Window
+const uint8_t LINK_LOSS_LIMIT = 6;
+const uint8_t LINK_RETRIES_LIMIT = 64;
+
+// Step Up Only Below Both Limits, with Strong Signal on Most Packets, Twice in a Row
+const uint8_t LINK_LOSS_CLEAN = 1;
+const uint8_t LINK_RETRIES_CLEAN = 8;
+const uint8_t LINK_STRONG_MIN = LINK_WINDOW_PACKETS * 3 / 4;
+const uint8_t LINK_CLEAN_WINDOWS = 2;
+
+// Clean Windows Required Again Double Each Time a Step Up Fails, Up to This Many
+const uint8_t LINK_CLEAN_WINDOWS_MAX = 64;
+
+// Packets Between the Announcement of a Profile and its Use
+const uint8_t LINK_ANNOUNCE_LEAD = 16;
+
+// Silence (or Failed Packets on the Controller) Before Falling Back to the Robust Profile
+const uint32_t LINK_FALLBACK_TIMEOUT_US = 50000;
+const uint8_t LINK_FALLBACK_FAILURES = 10;
+
+// Link Statistics
+typedef struct
+{
+  uint8_t profile;
+  uint8_t announced;
+  uint8_t apply_sequence;
+  uint16_t step_ups;
+  uint16_t step_downs;
+  uint16_t fallbacks;
+} link_stats;
+
+// Starts on the Robust Profile
+void link_begin(void);
+
+// Radio Settings of a Profile
+link_profile link_settings(uint8_t profile);
+
+// Records a Valid Packet (Lost Since the Previous One, Controller Retries, Strong Signal), Returns the Profile to Use
+uint8_t link_received(uint8_t sequence, uint8_t lost, uint8_t retries, bool strong, uint32_t now);
+
+// Falls Back to the Robust Profile When the Link Goes Silent, Returns the Profile to Use
+uint8_t link_update(uint32_t now);
+
+// Link Statistics (Announced Profile and Apply Sequence Go Into the Telemetry)
+const link_stats &link_statistics(void);
@@ -0,0 +1,58 @@
+// Mecanum Wheels Mixer
+#pragma once
+
+#include <stdint.h>
+
+/***********************************************************************************************************************
+ *
+ *  Continuous inverse kinematics for the four mecanum wheels in fixed point. Signed Q8 stick deflections (-256..256, see
+ *  sticks.h) are mixed into one signed duty cycle per wheel in a single pass:
+ *
+ *    front left  = forward - strafe - turn        front right = forward + strafe + turn
+ *    back left   = forward + strafe - turn        back right  = forward - strafe + turn
+ *
+ *  Positive strafe and turn head left, matching the X axes of the controller. Wheel duties are Q15 fractions of full
+ *  PWM, positive driving the wheel forward, so later stages keep more resolution than the 10-bit PWM of the motors.
+ *
+ **********************************************************************************************************************/
+
+// Wheels Order in Drive Commands
+enum wheel_index
+{
+  WHEEL_FRONT_LEFT = 0,
+  WHEEL_FRONT_RIGHT,
+  WHEEL_BACK_LEFT,
+  WHEEL_BACK_RIGHT,
+  NUMBER_WHEELS
+};
+
+// Fixed Point Scales
+const int16_t DEFLECTION_FULL_SCALE = 256;
+const int16_t DUTY_FULL_SCALE = 32767;
+const uint8_t SPEED_TO_DUTY_SHIFT = 7;
+
+// Motor PWM Resolution (Full Duty is PWM_TOP)
+const uint8_t PWM_BITS = 10;
+const uint16_t PWM_TOP = (1 << PWM_BITS) - 1;
+
+// Signed Duty Cycle of Each Wheel
+typedef struct
+{
+  int16_t duty[NUMBER_WHEELS];
+} drive_command;
+
+// Mixes Forward, Strafe and Turn Deflections into Wheel Duties Between speed_min and speed_max (8-bit Speed Units)
+//  - MODE true:  X1 stick turns and X2 stick strafes
+//  - MODE false: X1 stick strafes and X2 stick turns
+template <bool MODE>
+void mix_drive(int16_t forward, int16_t x1, int16_t x2, uint8_t speed_min, uint8_t speed_max, drive_command &command);
+
+// Converts a Q15 Wheel Duty to the PWM Value (0..PWM_TOP) and Direction Used by the Motor Driver
+inline uint16_t duty_to_pwm(int16_t duty)
+{
+  return (uint16_t)((duty < 0 ? -duty : duty) >> (15 - PWM_BITS));
+}
+inline bool duty_to_direction(int16_t duty)
+{
+  return duty > 0;
+}
@@ -0,0 +1,160 @@
+// L298P Motor Shield Driver
+#pragma once
+
+#include <Arduino.h>
+#include "mixer.h"
+
+/***********************************************************************************************************************
+ *
+ *  Each wheel is a motor_channel bound to its direction and enable pins at compile time. On the ATmega32u4 the pins
+ *  resolve to their port bit and to the output compare register of the timer behind them, so a write is a couple of
+ *  instructions instead of the pin table lookups of digitalWrite()/analogWrite(). motors_write() updates the four
+ *  wheels inside one critical section and only touches the registers of the wheels whose command changed.
+ *
+ *  motors_begin() takes Timer1 (ENC, END), Timer3 (ENB) and Timer4 (ENA) over from the Arduino core and runs them in
+ *  fast PWM from the 16 MHz clock with PWM_TOP as their top, so the four enable pins switch together at the same
+ *  15.6 kHz with 10-bit duties instead of the 8-bit ~490 Hz analogWrite() gives them. Timer0, and with it millis(),
+ *  micros() and the ADC trigger, is left alone. The timers stay shared with pins 11 and 13, which only take
+ *  digitalWrite() here; an analogWrite() on them would now use the 10-bit scale.
+ *
+ *  Duties 0 and PWM_TOP disconnect the timer from the pin and drive it low or high, exactly like analogWrite() does
+ *  at 0 and 255, so a stopped or full speed wheel sees no switching at all. Other targets fall back to
+ *  digitalWrite()/analogWrite(), with the duty reduced to analogWrite()'s 8 bits.
+ *
+ **********************************************************************************************************************/
+
+// L298P Direction Control Pins (DIRA and DIRC Jumpers Can Move to A4 or A5 to Free INT0 or INT6 for an Encoder)
+#ifndef MOTOR_PIN_DIRA
+#define MOTOR_PIN_DIRA 3
+#endif
+#ifndef MOTOR_PIN_DIRC
+#define MOTOR_PIN_DIRC 7
+#endif
+const uint8_t PIN_DIRA = MOTOR_PIN_DIRA;
+const uint8_t PIN_DIRB = 4;
+const uint8_t PIN_DIRC = MOTOR_PIN_DIRC;
+const uint8_t PIN_DIRD = 8;
+
+// L298P Enable Control Pins
+const uint8_t PIN_ENA = 6;
+const uint8_t PIN_ENB = 5;
+const uint8_t PIN_ENC = 10;
+const uint8_t PIN_END = 9;
+
+#if defined(__AVR_ATmega32U4__)
+
+// Port Bit of Each Shield Pin (Arduino Leonardo Pinout)
+template <uint8_t PIN>
+struct pin_traits;
+#define MOTOR_PIN_TRAITS(pin, port_register, bit)             \
+  template <>                                                 \
+  struct pin_traits<pin>                                      \
+  {                                                           \
+    static volatile uint8_t &port() { return port_register; } \
+    static const uint8_t mask = (1 << bit);                   \
+  }
+MOTOR_PIN_TRAITS(3, PORTD, 0);
+MOTOR_PIN_TRAITS(4, PORTD, 4);
+MOTOR_PIN_TRAITS(5, PORTC, 6);
+MOTOR_PIN_TRAITS(6, PORTD, 7);
+MOTOR_PIN_TRAITS(7, PORTE, 6);
+MOTOR_PIN_TRAITS(8, PORTB, 4);
+MOTOR_PIN_TRAITS(9, PORTB, 5);
+MOTOR_PIN_TRAITS(10, PORTB, 6);
+MOTOR_PIN_TRAITS(22, PORTF, 1);
+MOTOR_PIN_TRAITS(23, PORTF, 0);
+
+// Timer Output of Each Enable Pin (Timer4 Takes the High Bits of its 10-bit Registers Through TC4H)
+template <uint8_t PIN>
+struct pwm_traits;
+#define MOTOR_PWM_TRAITS(pin, control_register, output_bit, compare_register) \
+  template <>                                                                 \
+  struct pwm_traits<pin>                                                      \
+  {                                                                           \
+    static void connect() { control_register |= (1 << output_bit); }         \
+    static void disconnect() { control_register &= ~(1 << output_bit); }      \
+    static void duty(uint16_t value) { compare_register = value; }            \
+  }
+MOTOR_PWM_TRAITS(5, TCCR3A, COM3A1, OCR3A);
+MOTOR_PWM_TRAITS(9, TCCR1A, COM1A1, OCR1A);
+MOTOR_PWM_TRAITS(10, TCCR1A, COM1B1, OCR1B);
+template <>
+struct pwm_traits<6>
+{
+  static void connect() { TCCR4C |= (1 << COM4D1); }
+  static void disconnect() { TCCR4C &= ~(1 << COM4D1); }
+  static void duty(uint16_t value)
+  {
+    TC4H = value >> 8;
+    OCR4D = value & 0xFF;
+  }
+};
+
+#endif
+
+// One L298P Channel (direction() and speed() Expect Interrupts Disabled)
+template <uint8_t DIR_PIN, uint8_t EN_PIN>
+struct motor_channel
+{
+  static void begin(void)
+  {
+    pinMode(DIR_PIN, OUTPUT);
+    pinMode(EN_PIN, OUTPUT);
+    digitalWrite(DIR_PIN, LOW);
+    analogWrite(EN_PIN, 0);
+  }
+
+  static void direction(bool dir)
+  {
+#if defined(__AVR_ATmega32U4__)
+    if (dir)
+    {
+      pin_traits<DIR_PIN>::port() &= ~pin_traits<DIR_PIN>::mask;
+    }
+    else
+    {
+      pin_traits<DIR_PIN>::port() |= pin_traits<DIR_PIN>::mask;
+    }
+#else
+    digitalWrite(DIR_PIN, dir ? LOW : HIGH);
+#endif
+  }
+
+  static void speed(uint16_t value)
+  {
+#if defined(__AVR_ATmega32U4__)
+    if (value == 0)
+    {
+      pwm_traits<EN_PIN>::disconnect();
+      pin_traits<EN_PIN>::port() &= ~pin_traits<EN_PIN>::mask;
+    }
+    else if (value >= PWM_TOP)
+    {
+      pwm_traits<EN_PIN>::disconnect();
+      pin_traits<EN_PIN>::port() |= pin_traits<EN_PIN>::mask;
+    }
+    else
+    {
+      pwm_traits<EN_PIN>::duty(value);
+      pwm_traits<EN_PIN>::connect();
+    }
+#else
+    analogWrite(EN_PIN, value >> (PWM_BITS - 8));
+#endif
+  }
+};
+
+// Shield Channels of Each Wheel
+typedef motor_channel<PIN_DIRB, PIN_ENB> motor_front_left;
+typedef motor_channel<PIN_DIRD, PIN_END> motor_front_right;
+typedef motor_channel<PIN_DIRA, PIN_ENA> motor_back_left;
+typedef motor_channel<PIN_DIRC, PIN_ENC> motor_back_right;
+
+// Configures the PWM Timers and the Shield Pins and Stops the Motors
+void motors_begin(void);
+
+// Applies the Four Wheel Duties at Once
+void motors_write(const drive_command &command);
+
+// Stops the Four Wheels
+void motors_stop(void);
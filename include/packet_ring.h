@@ -0,0 +1,68 @@
+// Interrupt to Loop Packet Ring Buffer
+#pragma once
+
+#include <stdint.h>
+
+/***********************************************************************************************************************
+ *
+ *  Lock-free single producer / single consumer ring. The producer (an interrupt handler) owns the head index and the
+ *  consumer (the loop) owns the tail index; both are single bytes, so reads and writes of them are atomic on AVR and
+ *  no interrupts ever need to be disabled. Slots are filled and read in place through reserve()/commit() and
+ *  front()/release(), so a packet can go from the radio FIFO to its consumer without intermediate copies.
+ *
+ **********************************************************************************************************************/
+
+// Keeps the Compiler from Moving Slot Accesses Across Index Updates
+#define PACKET_RING_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+template <typename T, uint8_t SIZE>
+class packet_ring
+{
+  static_assert(SIZE >= 2 && (SIZE & (SIZE - 1)) == 0, "packet_ring size must be a power of two");
+
+public:
+  packet_ring() : head(0), tail(0) {}
+
+  // Producer Side: Slot to Fill, or NULL When Full
+  T *reserve(void)
+  {
+    uint8_t next = (head + 1) & (SIZE - 1);
+    return (next == tail) ? 0 : &slots[head];
+  }
+
+  // Producer Side: Publishes the Reserved Slot
+  void commit(void)
+  {
+    PACKET_RING_BARRIER();
+    head = (head + 1) & (SIZE - 1);
+  }
+
+  // Consumer Side: Oldest Slot, or NULL When Empty
+  T *front(void)
+  {
+    if (tail == head)
+    {
+      return 0;
+    }
+    PACKET_RING_BARRIER();
+    return &slots[tail];
+  }
+
+  // Consumer Side: Frees the Oldest Slot
+  void release(void)
+  {
+    PACKET_RING_BARRIER();
+    tail = (tail + 1) & (SIZE - 1);
+  }
+
+  // Number of Slots Waiting for the Consumer
+  uint8_t count(void) const
+  {
+    return (head - tail) & (SIZE - 1);
+  }
+
+private:
+  T slots[SIZE];
+  volatile uint8_t head;
+  volatile uint8_t tail;
+};
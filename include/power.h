@@ -0,0 +1,41 @@
+// Low Power Idle
+#pragma once
+
+#include <stdint.h>
+
+/***********************************************************************************************************************
+ *
+ *  Cuts the current the robot draws while it has nothing to do, at two levels:
+ *    - between tasks the MCU sleeps in IDLE mode up to the next Timer0 wake point: the overflow that drives millis()
+ *      and two compare matches at fixed counts, a third of the ~1 ms overflow period apart (the core runs Timer0 in
+ *      fast PWM, where a compare value only takes effect at the next overflow, so the compares are never moved). It
+ *      only sleeps when that wake point comes no later than the next task release and polls the gap left otherwise,
+ *      so tasks keep their release grid and nothing runs later than it would without sleeping. Other interrupts (the
+ *      radio IRQ, an ADC conversion, USB) wake it earlier
+ *    - once the failsafe has kept the robot stopped for POWER_IDLE_DELAY_MS, the robot goes idle: the radio only
+ *      listens for POWER_LISTEN_MS of every POWER_LISTEN_PERIOD_MS and is powered down the rest of the time, and the
+ *      LED strips are turned off. The first packet caught in a listening window ends the idle period.
+ *
+ **********************************************************************************************************************/
+
+// Stopped Time Before Going Idle (Milliseconds)
+const uint16_t POWER_IDLE_DELAY_MS = 5000;
+
+// Radio Listening Windows While Idle (Milliseconds, a Window Spans Several Controller Packets)
+const uint16_t POWER_LISTEN_PERIOD_MS = 500;
+const uint16_t POWER_LISTEN_MS = 60;
+
+// Shortest Gap Worth Sleeping Through (Microseconds)
+const uint16_t POWER_SLEEP_MIN_US = 16;
+
+// Sets the Timer0 Compare Wakes (Timer0 Compare Outputs Stay Disconnected, No analogWrite() on Pins 3 and 11)
+void power_begin(void);
+
+// Follows the Failsafe (stopped While No Packets Drive the Robot), Returns True While Idle
+bool power_update(bool stopped, unsigned long now);
+
+// True While the Radio Should Be Listening
+bool power_radio_window(unsigned long now);
+
+// Sleeps for at Most idle_us Microseconds (Not at All if No Wake Point Comes Within), Less if an Interrupt Comes First
+void power_sleep(uint32_t idle_us);
@@ -0,0 +1,51 @@
+// Loop Stages Profiler
+#pragma once
+
+#include <stdint.h>
+
+/***********************************************************************************************************************
+ *
+ *  With PROFILE defined before this header, PROFILE_BEGIN()/PROFILE_END() timestamp a stage of the loop straight from
+ *  the Timer0 counter (one tick is 64 CPU cycles, 4 us on the 16 MHz Leonardo) and keep count, min, max, total and a
+ *  log2 histogram per stage in RAM. profiler_report() sends them as one binary frame, decoded on the computer by
+ *  scripts/profile_decode.py, so the reporting costs one short USB write instead of a stream of Serial.print() calls.
+ *  Statistics restart after every report. Without PROFILE the macros compile to nothing.
+ *
+ *  Report frame (little endian):
+ *    0xA5 0x5A | version (1) | stages (1) | tick length in ns (2) | per stage: count (2), min (2), max (2),
+ *    total (4), histogram (8 x 2) | checksum (1, two's complement of the byte sum of everything before it)
+ *
+ **********************************************************************************************************************/
+
+// Profiled Stages
+enum profile_stage
+{
+  PROFILE_BATTERY = 0,
+  PROFILE_RADIO,
+  PROFILE_DEBOUNCE,
+  PROFILE_MIXING,
+  PROFILE_MOTORS,
+  PROFILE_LIGHTS,
+  NUMBER_PROFILE_STAGES
+};
+
+// Histogram Buckets (Bucket 0 Holds Zero Ticks, Bucket N Holds 2^(N-1) to 2^N - 1 Ticks, the Last One the Rest)
+const uint8_t PROFILE_BUCKETS = 8;
+const uint8_t PROFILE_FRAME_VERSION = 1;
+
+// Current Profiler Clock (Ticks)
+uint16_t profiler_ticks(void);
+
+// Adds One Duration to the Statistics of a Stage
+void profiler_record(uint8_t stage, uint16_t ticks);
+
+// Sends the Statistics Frame over the Serial Port and Starts Over
+void profiler_report(void);
+
+#ifdef PROFILE
+#define PROFILE_BEGIN(stage) uint16_t profile_start_##stage = profiler_ticks()
+#define PROFILE_END(stage) profiler_record(stage, profiler_ticks() - profile_start_##stage)
+#else
+#define PROFILE_BEGIN(stage)
+#define PROFILE_END(stage)
+#endif
@@ -0,0 +1,62 @@
+// Controller Packet Wire Format
+#pragma once
+
+#include <stdint.h>
+#include "controller.h"
+
+/***********************************************************************************************************************
+ *
+ *  What actually goes over the air, independent of the controller_variables layout: the six buttons as one bitfield,
+ *  the four sticks and two sliders as contiguous 10-bit fields, a sequence number so lost packets can be counted and a
+ *  CRC-8 over everything before it. 12 bytes instead of the 18 of the struct. The robot reads frames straight into its
+ *  receive ring and decodes them from there into controller_variables, so no intermediate buffer is involved.
+ *
+ *  Layout (little endian bit order inside analog[]):
+ *    version | sequence | buttons (bit n = button n + 1, bits 6-7 retries) |
+ *    X1 Y1 X2 Y2 slider1 slider2 (6 x 10 bits) | crc
+ *
+ *  The top two bits of the buttons byte carry the retransmissions the controller needed for its previous packet
+ *  (saturated at 3), which the robot uses to judge the link.
+ *
+ **********************************************************************************************************************/
+
+// Wire Format Version (Frames of Any Other Version are Rejected)
+const uint8_t RADIO_FRAME_VERSION = 2;
+
+// Buttons Byte Fields
+const uint8_t RADIO_FRAME_BUTTONS_MASK = 0x3F;
+const uint8_t RADIO_FRAME_RETRIES_SHIFT = 6;
+const uint8_t RADIO_FRAME_RETRIES_MAX = 3;
+
+// Analog Readings Packed in the Frame
+const uint8_t RADIO_FRAME_ANALOGS = 6;
+const uint8_t RADIO_FRAME_ANALOG_BITS = 10;
+
+// Wire Frame
+typedef struct __attribute__((packed))
+{
+  uint8_t version;
+  uint8_t sequence;
+  uint8_t buttons;
+  uint8_t analog[(RADIO_FRAME_ANALOGS * RADIO_FRAME_ANALOG_BITS + 7) / 8];
+  uint8_t crc;
+} radio_frame;
+
+// CRC-8 (Polynomial 0x07, Initial Value 0xFF)
+uint8_t radio_frame_crc(const uint8_t *data, uint8_t length);
+
+// Builds a Frame from the Controller Readings (Analog Readings and Retries Are Clamped to Their Fields)
+void radio_frame_encode(const controller_variables &controller, uint8_t sequence, radio_frame &frame,
+                        uint8_t retries = 0);
+
+// Retries the Controller Reported in a Frame
+inline uint8_t radio_frame_retries(const radio_frame &frame)
+{
+  return frame.buttons >> RADIO_FRAME_RETRIES_SHIFT;
+}
+
+// Checks Version and CRC of a Frame
+bool radio_frame_valid(const radio_frame &frame);
+
+// Unpacks a Frame into the Controller Readings
+void radio_frame_decode(const radio_frame &frame, controller_variables &controller);
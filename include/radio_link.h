@@ -0,0 +1,76 @@
+// Robot Radio Link
+#pragma once
+
+#include <stdint.h>
+#include "controller.h"
+#include "telemetry.h"
+
+/***********************************************************************************************************************
+ *
+ *  Owns the nRF24L01 radio. Received packets are drained from the radio RX FIFO into a single producer / single
+ *  consumer ring and handed to the loop from there. When the radio IRQ line is wired (build with
+ *  -D RADIO_IRQ_PIN=<pin>, an external interrupt pin such as 2 on the Leonardo) the draining runs in the interrupt
+ *  handler and the loop never touches SPI; otherwise radio_link_receive() drains the FIFO by polling first.
+ *
+ *  Every packet read from the FIFO is followed by loading the latest telemetry frame as the ack payload of the next
+ *  packet, so the robot reports back without ever leaving listening mode.
+ *
+ *  Packets travel as radio_frame (see radio_frame.h). Frames of the wrong size or version count as malformed, frames
+ *  failing the CRC as corrupted, and every gap in the sequence numbers as lost, whatever the cause (so it includes the
+ *  packets discarded for any of the reasons above). A sequence number that goes back instead (a controller restarted
+ *  from 0, a repeated packet) counts as a resync and the count goes on from there.
+ *
+ *  With -D RADIO_HOPPING the radio surveys the band at start and hops channels as described in channel_hopping.h,
+ *  with hopping_statistics() reporting the per-channel losses, drops and re-syncs. With -D RADIO_ADAPTIVE_RATE it
+ *  adapts its data rate and power level as described in link_manager.h, reported by link_statistics(); otherwise it
+ *  stays at the default 1 Mbps and maximum power.
+ *
+ **********************************************************************************************************************/
+
+// Radio Control Pins
+const uint8_t PIN_RADIO_CE = 11;
+const uint8_t PIN_RADIO_CSN = 12;
+
+// Packets the Ring Can Hold Between Two Loop Reads (Power of Two, Above the 3-Level RX FIFO)
+const uint8_t RADIO_RING_SIZE = 4;
+
+// Longest Sequence Gap Counted as Lost, Larger Ones Wrap to a Jump Backwards
+const uint8_t RADIO_LOST_MAX = 127;
+
+// Radio Link Statistics
+typedef struct
+{
+  uint32_t received;
+  uint16_t overflows;
+  uint16_t superseded;
+  uint16_t malformed;
+  uint16_t corrupted;
+  uint16_t lost;
+  uint16_t resyncs;
+  uint16_t latency_us;
+  uint16_t latency_max_us;
+} radio_link_stats;
+
+// Received Packet Details (Arrival is When the Packet Left the Radio FIFO, in micros())
+typedef struct
+{
+  uint8_t pipe;
+  uint8_t sequence;
+  uint32_t received_at;
+} radio_link_packet;
+
+// Initializes and Configures the Radio, False if the Radio Does Not Respond: pet Runs Between the Passes of the Band
+// Survey (NULL for None), Long Enough Together to Need the Watchdog Petted Meanwhile
+bool radio_link_begin(void (*pet)(void));
+
+// Powers the Radio Down (Nothing is Received Meanwhile) or Back Up Listening
+void radio_link_power(bool on);
+
+// Takes the Newest Received Packet, if Any, Dropping Older Ones Still Waiting
+bool radio_link_receive(controller_variables &controller, radio_link_packet &packet);
+
+// Sets the Telemetry Frame Loaded into the Next Acknowledgements
+void radio_link_set_telemetry(const telemetry_frame &telemetry);
+
+// Reception Statistics (Latency is From the Packet Leaving the Radio FIFO to the Loop Taking It)
+const radio_link_stats &radio_link_statistics(void);
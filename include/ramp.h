@@ -0,0 +1,41 @@
+// Wheel Duty Ramps
+#pragma once
+
+#include <stdint.h>
+#include "mixer.h"
+
+/***********************************************************************************************************************
+ *
+ *  Sits between the mixer and the motor driver and moves each wheel duty towards its target by at most one step per
+ *  control tick, so the ramps run at the control rate whatever the packet timing. Steps come from the time a wheel
+ *  takes to cover the full duty scale accelerating and decelerating, set per wheel by a ramp_profile.
+ *
+ *  Duties below the floor (the speed_min the mixer adds to every moving wheel) do not turn the wheels, so a wheel
+ *  starting from rest jumps straight to the floor and one stopping drops from the floor to zero. A wheel asked to
+ *  reverse first decelerates to zero and stays there, coasting, for coast_ms before accelerating the other way, so the
+ *  L298P never flips a direction pin on a spinning motor.
+ *
+ **********************************************************************************************************************/
+
+// Ramp Profile (Times in Milliseconds, 0 for No Limit)
+typedef struct
+{
+  uint16_t accel_ms;
+  uint16_t decel_ms;
+  uint8_t coast_ms;
+} ramp_profile;
+
+// Ramp Profiles
+const ramp_profile RAMP_GENTLE = {400, 200, 30};
+const ramp_profile RAMP_NORMAL = {250, 120, 20};
+const ramp_profile RAMP_SPORT = {120, 60, 10};
+const ramp_profile RAMP_NONE = {0, 0, 0};
+
+// Sets the Ramp of One Wheel for Ramps Stepped Every tick_us Microseconds
+void ramp_configure(uint8_t wheel, const ramp_profile &profile, uint32_t tick_us);
+
+// Steps Every Wheel One Tick Towards the Target Duties (floor in Q15 Duty Units)
+void ramp_update(const drive_command &target, int16_t floor, drive_command &output);
+
+// Sets Every Wheel to Rest at Once (After an Emergency Stop)
+void ramp_reset(void);
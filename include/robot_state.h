@@ -0,0 +1,51 @@
+// Robot Runtime State
+#pragma once
+
+#include <stdint.h>
+
+/***********************************************************************************************************************
+ *
+ *  Everything the tasks of src/main.cpp share from one run to the next lives in a single robot_state instead of a
+ *  scatter of globals: the commands taken from the latest packet, the battery reading and its timer, the blink timer,
+ *  and every on/off flag packed as a bit of two bytes. Constants stay out of it (and, for tables, out of SRAM too).
+ *  Build the leonardo environment to see what it, and every other symbol, costs in the size report.
+ *
+ **********************************************************************************************************************/
+
+// Robot Runtime State
+typedef struct __attribute__((packed))
+{
+  // Commands From the Latest Packet (Q8 Deflections, 8-bit Speed)
+  int16_t forward;
+  int16_t lateral1;
+  int16_t lateral2;
+  uint8_t speed_max;
+
+  // Sliders Sum speed_max Was Last Worked Out From
+  uint16_t sliders;
+
+  // Filtered Battery Reading and When it Was Last Above the Minimum
+  uint16_t bat_reading;
+  uint32_t low_battery_time;
+
+  // Blinkers Phase Timer
+  uint32_t blink_time;
+
+  // Last Attempt at a Radio That Failed to Start (Low Bits of millis())
+  uint16_t radio_retry_time;
+
+  // Flags (Mode True is Mode 1)
+  bool mode : 1;
+  bool front_light : 1;
+  bool back_light : 1;
+  bool enable_blink : 1;
+  bool blink_right : 1;
+  bool blink_left : 1;
+  bool hazard_light : 1;
+  bool blink : 1;
+  bool battery_charged : 1;
+  bool calibrating : 1;
+  bool radio_ready : 1;
+  bool radio_listening : 1;
+  bool idle : 1;
+} robot_state;
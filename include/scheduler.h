@@ -0,0 +1,34 @@
+// Fixed Rate Cooperative Scheduler
+#pragma once
+
+#include <stdint.h>
+
+/***********************************************************************************************************************
+ *
+ *  Tasks declare a period and a run time budget in microseconds and are released on a fixed grid of micros() ticks, so
+ *  a task that runs late does not shift the ones after it. Every task keeps its worst run time and counts budget
+ *  overruns and missed periods, which bounds and exposes how long any stage can hold the loop. Each pass tells how long
+ *  the loop may sleep before the next release.
+ *
+ **********************************************************************************************************************/
+
+// Scheduled Task
+typedef struct
+{
+  void (*run)(void);
+  uint32_t period_us;
+  uint16_t budget_us;
+  uint32_t next_release;
+  uint16_t max_us;
+  uint16_t overruns;
+  uint16_t missed;
+} scheduler_task;
+
+// Declares a Task Running at the Given Rate with the Given Budget
+#define SCHEDULER_TASK(function, rate_hz, budget_us) {function, 1000000UL / (rate_hz), budget_us, 0, 0, 0, 0}
+
+// Aligns the First Release of Every Task to Now
+void scheduler_begin(scheduler_task *tasks, uint8_t count);
+
+// Runs Every Task Whose Release Time Has Come, in Table Order, Returns the Microseconds Until the Next Release
+uint32_t scheduler_run(scheduler_task *tasks, uint8_t count);
@@ -0,0 +1,55 @@
+// Closed Loop Wheel Speed Control
+#pragma once
+
+#include <stdint.h>
+#include "mixer.h"
+
+/***********************************************************************************************************************
+ *
+ *  Sits between the ramps and the motor driver and turns each wheel duty into a speed target: a duty is the fraction of
+ *  SPEED_FULL_SCALE_HZ (encoder edges per second at full duty with no load, on the nominal battery of
+ *  voltage_compensation.h) the wheel should turn at. A fixed point PID per wheel, stepped every control tick, adds its
+ *  correction to the target itself used as the feed forward, so load, surface and battery charge no longer change how
+ *  fast a given stick deflection turns the wheels.
+ *
+ *  Speed is measured from the edges counted over the last SPEED_WINDOW control ticks, in the direction the wheel is
+ *  driven. The correction can slow a wheel down to rest but never reverses it, and the integral stops growing while
+ *  the output saturates. A zero target stops the wheel and clears its controller. Wheels without an encoder, and every
+ *  wheel with SPEED_GAINS_OPEN, pass their duty through unchanged.
+ *
+ **********************************************************************************************************************/
+
+// Encoder Edges per Second at Full Speed
+#ifndef SPEED_FULL_SCALE_HZ
+#define SPEED_FULL_SCALE_HZ 2900
+#endif
+
+// Control Ticks per Speed Measurement
+const uint8_t SPEED_WINDOW = 8;
+
+// Integral Term Limit (Q15 Duty Units)
+const int16_t SPEED_INTEGRAL_LIMIT = DUTY_FULL_SCALE / 2;
+
+// PID Gains (Q8, 256 is 1.0, Integral and Derivative per Control Tick)
+typedef struct
+{
+  uint16_t kp;
+  uint16_t ki;
+  uint16_t kd;
+} speed_gains;
+
+// Gain Sets
+const speed_gains SPEED_GAINS_DEFAULT = {192, 24, 0};
+const speed_gains SPEED_GAINS_OPEN = {0, 0, 0};
+
+// Starts the Controllers for the Wheels in the Mask (Bit N is Wheel N) Stepped Every tick_us Microseconds
+void speed_control_begin(uint8_t encoded, uint32_t tick_us);
+
+// Sets the Gains of Every Wheel
+void speed_control_configure(const speed_gains &gains);
+
+// Steps the Controllers with the Edges Counted Over the Last Tick (output May Be the Same Command as target)
+void speed_control_update(const drive_command &target, const uint8_t edges[NUMBER_WHEELS], drive_command &output);
+
+// Clears the Controllers and Measurements (After an Emergency Stop)
+void speed_control_reset(void);
@@ -0,0 +1,102 @@
+// Calibrated Stick Response
+#pragma once
+
+#include <stdint.h>
+#include "controller.h"
+
+/***********************************************************************************************************************
+ *
+ *  Turns raw stick readings into signed Q8 deflections (-256..256) through a calibration of each axis (its center,
+ *  deadband and both ends) and a response curve. Everything that needs a division (the reciprocals of the travel on
+ *  each side of the deadband) is worked out when a calibration is loaded or measured, so a deflection costs one
+ *  multiply and, for the expo curve, one interpolated lookup in a flash table.
+ *
+ *  Calibrations come from three places, each overriding the previous one:
+ *    - defaults matching the fixed 500..550 deadband over the full 0..1023 travel
+ *    - at start, the sticks at rest over the first STICKS_REST_PACKETS packets: centers and a deadband just wider than
+ *      their jitter, kept only if every reading stayed within STICKS_REST_TOLERANCE of the middle
+ *    - a full calibration stored in EEPROM, measured on command by holding buttons 3 and 4 (the lights, not the horn)
+ *      for STICKS_HOLD_MS with every stick inside its deadband, so driving never starts one: the sticks are left at
+ *      rest for STICKS_CENTER_MS, then swept to their ends for STICKS_SWEEP_MS
+ *  Deflections read zero while a calibration is being measured. Sticks at rest are only taken as such while every
+ *  center stays within STICKS_REST_TOLERANCE of the middle and every jitter within STICKS_JITTER_MAX: a stick held
+ *  off center or a sweep started early leaves the calibration in use as it was.
+ *
+ **********************************************************************************************************************/
+
+// Stick Axes
+enum stick_axis
+{
+  AXIS_X1 = 0,
+  AXIS_Y1,
+  AXIS_X2,
+  AXIS_Y2,
+  NUMBER_AXES
+};
+
+// Response Curves
+enum stick_curve
+{
+  CURVE_LINEAR = 0,
+  CURVE_EXPO
+};
+
+// Raw Reading Range and Default Calibration (the Former Fixed Deadband)
+const uint16_t AXIS_READING_MAX = 1023;
+const uint16_t AXIS_DEFAULT_CENTER = 525;
+const uint8_t AXIS_DEFAULT_DEADBAND = 25;
+
+// Measured Deadbands (Jitter Plus Margin, Never Below the Minimum) and the Most Jitter Accepted at Rest
+const uint8_t STICKS_DEADBAND_MARGIN = 6;
+const uint8_t STICKS_DEADBAND_MIN = 8;
+const uint8_t STICKS_JITTER_MAX = 24;
+const uint8_t STICKS_DEADBAND_MAX = STICKS_JITTER_MAX + STICKS_DEADBAND_MARGIN;
+
+// Calibration at Start
+const uint8_t STICKS_REST_PACKETS = 16;
+const uint16_t STICKS_REST_TOLERANCE = 64;
+
+// Calibration on Command (Buttons 3 and 4, Mask in buttons_state() Order, Times in Milliseconds)
+const uint8_t STICKS_CALIBRATION_BUTTONS = 0x0C;
+const uint16_t STICKS_HOLD_MS = 3000;
+const uint16_t STICKS_CENTER_MS = 1000;
+const uint16_t STICKS_SWEEP_MS = 5000;
+
+// Shortest Travel Accepted on Each Side of a Swept Center
+const uint16_t STICKS_TRAVEL_MIN = 256;
+
+// Calibration Storage
+const uint16_t STICKS_EEPROM_ADDRESS = 0;
+const uint8_t STICKS_EEPROM_VERSION = 1;
+
+// Calibration of One Axis (Raw Readings)
+typedef struct
+{
+  uint16_t low;
+  uint16_t center;
+  uint16_t high;
+  uint8_t deadband;
+} axis_calibration;
+
+// Calibration Sources
+enum sticks_source
+{
+  STICKS_DEFAULT = 0,
+  STICKS_REST,
+  STICKS_STORED
+};
+
+// Loads the Stored Calibration (or the Defaults) and Sets the Response Curve of Each Axis
+void sticks_begin(const uint8_t curves[NUMBER_AXES]);
+
+// Feeds a Packet's Readings to the Calibration: buttons is the Debounced Buttons State, Returns True While Measuring
+bool sticks_update(const controller_variables &controller, uint8_t buttons, unsigned long now);
+
+// Where the Calibration in Use Came From
+uint8_t sticks_source(void);
+
+// Calibration in Use of an Axis
+const axis_calibration &sticks_calibration(uint8_t axis);
+
+// Converts a Raw Reading of an Axis to a Signed Q8 Deflection, Zero Inside the Deadband
+int16_t stick_deflection(uint8_t axis, uint16_t reading);
@@ -0,0 +1,52 @@
+// Robot to Controller Telemetry Frame
+#pragma once
+
+#include <stdint.h>
+
+/***********************************************************************************************************************
+ *
+ *  Sent back to the controller inside the acknowledgement of every packet it transmits (nRF24 ack payloads), so it
+ *  costs no extra air time nor any switch out of listening mode on the robot. The controller needs dynamic payloads
+ *  and ack payloads enabled on its side to receive it.
+ *
+ *  battery_percent is the state of charge of the pack and battery_minutes the driving minutes left before the battery
+ *  failsafe stops the robot, SOC_MINUTES_UNKNOWN until they are measured (see battery_soc.h).
+ *
+ *  reset_reason and boot_ms tell how the robot last started: the reset flags and the milliseconds from the start of the
+ *  sketch to the first packet it accepted (see boot.h).
+ *
+ *  link_profile and link_apply_sequence are filled by the radio link itself: the profile both ends use from the given
+ *  controller sequence number on (see link_manager.h), or LINK_FIXED when the robot does not adapt its link.
+ *
+ **********************************************************************************************************************/
+
+// Telemetry Frame Version
+const uint8_t TELEMETRY_VERSION = 4;
+
+// Telemetry Flags
+const uint8_t TELEMETRY_FAILSAFE = 0x01;
+const uint8_t TELEMETRY_LOW_BATTERY = 0x02;
+const uint8_t TELEMETRY_BATTERY_FAILSAFE = 0x04;
+const uint8_t TELEMETRY_MODE_2 = 0x08;
+const uint8_t TELEMETRY_TASK_OVERRUN = 0x10;
+const uint8_t TELEMETRY_DECELERATING = 0x20;
+const uint8_t TELEMETRY_CALIBRATING = 0x40;
+const uint8_t TELEMETRY_BATTERY_WARNING = 0x80;
+
+// Telemetry Frame
+typedef struct __attribute__((packed))
+{
+  uint8_t version;
+  uint8_t flags;
+  uint16_t battery_mv;
+  uint8_t battery_percent;
+  uint8_t battery_minutes;
+  uint16_t loop_max_us;
+  uint16_t loop_overruns;
+  uint16_t packets_received;
+  uint16_t packets_dropped;
+  uint8_t reset_reason;
+  uint16_t boot_ms;
+  uint8_t link_profile;
+  uint8_t link_apply_sequence;
+} telemetry_frame;
@@ -0,0 +1,48 @@
+// Battery Voltage Compensation of the Wheel Duties
+#pragma once
+
+#include <stdint.h>
+#include "mixer.h"
+#include "battery.h"
+
+/***********************************************************************************************************************
+ *
+ *  Scales every wheel duty by the ratio between the motor voltage on the nominal battery and on the measured one, so a
+ *  duty turns the wheels as fast on a full pack as on a drained one and speed_min stays right where it was tuned. The
+ *  ratio comes out of a flash table of reciprocals indexed by the battery reading, interpolated between entries and
+ *  built at compile time, so neither the control path nor the battery task divides.
+ *
+ *  The battery reading is smoothed once more (2^COMPENSATION_FILTER_SHIFT battery task runs) so the sag under motor
+ *  current is not chased back into the duties. Scaled duties saturate at full duty: on a battery below nominal the
+ *  fastest settings top out at what the pack can still give.
+ *
+ **********************************************************************************************************************/
+
+// Nominal Battery and L298P Bridge Drop (Volts)
+constexpr float COMPENSATION_NOMINAL_VOLTAGE = 7.4;
+constexpr float COMPENSATION_BRIDGE_DROP = 1.4;
+
+// Reciprocals Table (Raw ADC Counts from the Lowest Entry, Step per Entry)
+constexpr float COMPENSATION_TABLE_VOLTAGE = 5.6;
+const uint8_t COMPENSATION_TABLE_SIZE = 64;
+const uint8_t COMPENSATION_TABLE_STEP_SHIFT = 1;
+
+// Scale Factors (Q12, 4096 is 1.0) and Their Limit
+const uint8_t COMPENSATION_FACTOR_SHIFT = 12;
+const uint16_t COMPENSATION_FACTOR_UNITY = 1 << COMPENSATION_FACTOR_SHIFT;
+const uint16_t COMPENSATION_FACTOR_MAX = 2 * COMPENSATION_FACTOR_UNITY;
+
+// Extra Smoothing of the Battery Reading
+const uint8_t COMPENSATION_FILTER_SHIFT = 2;
+
+// Starts the Compensation from a Filtered Battery Reading
+void compensation_begin(uint16_t reading);
+
+// Feeds a Filtered Battery Reading (From the Battery Task)
+void compensation_update(uint16_t reading);
+
+// Current Scale Factor (Q12)
+uint16_t compensation_factor(void);
+
+// Scales the Wheel Duties (output May Be the Same Command as input)
+void compensation_apply(const drive_command &input, drive_command &output);
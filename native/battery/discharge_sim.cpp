@@ -0,0 +1,203 @@
+// Host (Native) Battery Discharge Simulation
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "native_hal.h"
+#include "mixer.h"
+#include "battery.h"
+#include "battery_soc.h"
+
+/***********************************************************************************************************************
+ *
+ *  Drains a simulated 2S LiPo pack, from full down to the battery failsafe, through the state of charge estimator of
+ *  battery_soc.h. The pack is an open circuit voltage following the discharge curve the charge table is built from,
+ *  behind an internal resistance, drawing a current proportional to the total wheel duty of a repeating drive cycle.
+ *  Its terminal voltage goes through the ADC (quantized, with one count of noise) and the IIR filter of the ATmega32u4,
+ *  the duties through soc_load() at the control rate and the readings through soc_update() at the battery task rate.
+ *  Every minute the estimate is printed next to the true charge, open circuit voltage, sag at full load and driving
+ *  minutes left before the failsafe, the latter known once the run has ended.
+ *
+ *  Usage: program [resistance_mohm] [capacity_mah] [full_load_amps]
+ *
+ **********************************************************************************************************************/
+
+// Simulation Parameters (ADC Sampled Every Millisecond, Close to the Timer0 Overflow)
+const uint32_t CONTROL_PERIOD_MS = 2;
+const uint32_t BATTERY_PERIOD_MS = 100;
+const uint32_t REPORT_PERIOD_MS = 60000;
+const uint32_t LIMIT_MS = 4 * 3600000UL;
+
+// Battery Failsafe of src/main.cpp
+constexpr float CUTOFF_VOLTAGE = 6.8;
+const uint16_t CUTOFF_DELAY_MS = 500;
+
+// Resting Voltage of One Cell Every 5 Percent of Charge (Volts, Empty First)
+const float CELL_CURVE[] = {3.27, 3.61, 3.69, 3.71, 3.73, 3.75, 3.77, 3.79, 3.80, 3.82, 3.84,
+                            3.85, 3.87, 3.91, 3.95, 3.98, 4.02, 4.08, 4.11, 4.15, 4.20};
+const uint8_t CELL_CURVE_POINTS = sizeof(CELL_CURVE) / sizeof(CELL_CURVE[0]);
+
+// Drive Cycle (Duration and Duty of All Four Wheels, Fraction of Full)
+typedef struct
+{
+  uint32_t duration_ms;
+  float duty;
+} drive_step;
+const drive_step DRIVE_CYCLE[] = {
+    {3000, 1.0f}, {2000, 0.0f}, {5000, 0.6f}, {1000, 0.0f}, {4000, 0.8f}, {3000, 0.4f}, {2000, 0.0f},
+};
+const uint8_t DRIVE_STEPS = sizeof(DRIVE_CYCLE) / sizeof(DRIVE_CYCLE[0]);
+
+// Report Row
+typedef struct
+{
+  uint32_t time_ms;
+  uint32_t driven_ms;
+  float charge;
+  float open_circuit;
+  soc_stats estimate;
+} report_row;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Get the Pack Open Circuit Voltage of a Charge (Percent)
+static float pack_voltage(float charge)
+{
+  float position = charge / 5;
+  if (position <= 0)
+  {
+    return SOC_CELLS * CELL_CURVE[0];
+  }
+  if (position >= CELL_CURVE_POINTS - 1)
+  {
+    return SOC_CELLS * CELL_CURVE[CELL_CURVE_POINTS - 1];
+  }
+  uint8_t point = (uint8_t)position;
+  float fraction = position - point;
+  return SOC_CELLS * (CELL_CURVE[point] + (CELL_CURVE[point + 1] - CELL_CURVE[point]) * fraction);
+}
+
+// Function to Get the Drive Cycle Duty at a Time
+static float cycle_duty(uint32_t time_ms)
+{
+  uint32_t period = 0;
+  for (uint8_t i = 0; i < DRIVE_STEPS; i++)
+  {
+    period += DRIVE_CYCLE[i].duration_ms;
+  }
+  uint32_t position = time_ms % period;
+  for (uint8_t i = 0; i < DRIVE_STEPS; i++)
+  {
+    if (position < DRIVE_CYCLE[i].duration_ms)
+    {
+      return DRIVE_CYCLE[i].duty;
+    }
+    position -= DRIVE_CYCLE[i].duration_ms;
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+  float resistance = (argc > 1) ? atof(argv[1]) / 1000 : 0.15f;
+  float capacity = (argc > 2) ? atof(argv[2]) : 2200;
+  float full_load = (argc > 3) ? atof(argv[3]) : 6;
+  if (argc > 4 || resistance < 0 || capacity <= 0 || full_load <= 0)
+  {
+    fprintf(stderr, "usage: %s [resistance_mohm] [capacity_mah] [full_load_amps]\n", argv[0]);
+    return 2;
+  }
+  native_reset();
+
+  // Full Pack at Rest, ADC Filter Seeded Like battery_begin()
+  float charge = 100;
+  uint16_t filtered = battery_counts(pack_voltage(charge)) >> BATTERY_FILTER_SHIFT << BATTERY_FILTER_SHIFT;
+  const uint16_t cutoff_reading = battery_counts(CUTOFF_VOLTAGE);
+  soc_begin(filtered, cutoff_reading);
+
+  std::vector<report_row> rows;
+  uint32_t driven_ms = 0;
+  uint32_t low_since = 0;
+  bool low = false;
+  uint32_t noise = 12345;
+  uint32_t t = 0;
+  for (; t < LIMIT_MS; t++)
+  {
+    // Pack Draws the Current of the Cycle Duty, Sagging Through its Resistance
+    float duty = cycle_duty(t);
+    float current = duty * full_load;
+    charge -= current / capacity * 100 / 3600;
+    float terminal = pack_voltage(charge) - current * resistance;
+    driven_ms += (duty * (1 << SOC_LOAD_FULL_SHIFT) >= SOC_DRIVING_LOAD) ? 1 : 0;
+
+    // ADC Conversion (One Count of Noise) Into the Battery Filter
+    noise = noise * 1103515245 + 12345;
+    int32_t counts = (battery_counts(terminal) >> BATTERY_FILTER_SHIFT) + (int32_t)((noise >> 16) % 3) - 1;
+    filtered = filtered - (filtered >> BATTERY_FILTER_SHIFT) + (counts < 0 ? 0 : counts);
+
+    // Control and Battery Tasks
+    if (t % CONTROL_PERIOD_MS == 0)
+    {
+      drive_command drive;
+      for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+      {
+        drive.duty[i] = (int16_t)(duty * DUTY_FULL_SCALE);
+      }
+      soc_load(drive);
+    }
+    if (t % BATTERY_PERIOD_MS == 0)
+    {
+      soc_update(filtered, t);
+
+      // Battery Failsafe Once the Reading Stays Below the Minimum
+      if (filtered > cutoff_reading)
+      {
+        low = false;
+      }
+      else if (!low)
+      {
+        low = true;
+        low_since = t;
+      }
+      else if (t - low_since > CUTOFF_DELAY_MS)
+      {
+        break;
+      }
+    }
+    if (t % REPORT_PERIOD_MS == 0)
+    {
+      report_row row = {t, driven_ms, charge, pack_voltage(charge), soc_statistics()};
+      rows.push_back(row);
+    }
+  }
+
+  printf("Pack %.0f mAh, %.0f mOhm, %.1f A at full load: failsafe after %.1f min (%.1f min driving)\n", capacity,
+         resistance * 1000, full_load, t / 60000.0, driven_ms / 60000.0);
+  printf("time (min)  charge %%  estimate %%  open (mV)  estimate (mV)  sag (mV)  estimate (mV)  left (min)  "
+         "estimate\n");
+  float worst = 0;
+  for (size_t i = 0; i < rows.size(); i++)
+  {
+    const report_row &row = rows[i];
+    float left = (driven_ms - row.driven_ms) / 60000.0;
+    float error = fabsf(row.estimate.percent - row.charge);
+    worst = (i > 0 && error > worst) ? error : worst;
+    printf("%10.0f %9.1f %11u %10.0f %14u %9.0f %14u %11.1f ", row.time_ms / 60000.0, row.charge,
+           row.estimate.percent, row.open_circuit * 1000, row.estimate.open_circuit_mv,
+           full_load * resistance * 1000, row.estimate.resistance_mv, left);
+    if (row.estimate.minutes == SOC_MINUTES_UNKNOWN)
+    {
+      printf("%9s\n", "-");
+    }
+    else
+    {
+      printf("%9u\n", row.estimate.minutes);
+    }
+  }
+  printf("Worst charge error after the first minute: %.1f %%\n", worst);
+  return 0;
+}
@@ -0,0 +1,159 @@
+// Host (Native) Benchmark of the Robot loop() Function
+#include <Arduino.h>
+#include <chrono>
+#include <stdio.h>
+#include "native_hal.h"
+#include "controller.h"
+#include "radio_frame.h"
+
+/***********************************************************************************************************************
+ *
+ *  Feeds synthetic controller packets through the unmodified setup()/loop() of src/main.cpp and reports how many loop
+ *  iterations per second the host achieves and what each iteration costs, for every stick branch of the drive logic
+ *  in both control modes, plus the idle, failsafe and low battery paths, and the share of the time the radio is powered
+ *  (lower once a long failsafe turns the robot idle).
+ *
+ *  Usage: program [iterations per scenario]
+ *
+ **********************************************************************************************************************/
+
+// Firmware Entry Points
+void setup();
+void loop();
+
+// Simulated Hardware Parameters
+const uint8_t PIN_BAT = A3;
+const uint16_t BAT_CHARGED = 328; // ~8.0 V through the 30k/7.5k divider
+const uint16_t BAT_DEPLETED = 250; // ~6.1 V through the 30k/7.5k divider
+const uint32_t PACKET_PERIOD_US = 2000;
+
+// Stick Positions
+const uint16_t LOW_END = 0;
+const uint16_t CENTER = 512;
+const uint16_t HIGH_END = 1023;
+
+// Benchmark Scenarios
+typedef struct
+{
+  const char *name;
+  bool send_packets;
+  uint16_t battery;
+  uint16_t X1axis;
+  uint16_t Y1axis;
+  uint16_t X2axis;
+  uint16_t Y2axis;
+  uint16_t settle_ms;
+} bench_scenario;
+
+const bench_scenario SCENARIOS[] = {
+    {"centered", true, BAT_CHARGED, CENTER, CENTER, CENTER, CENTER, 400},
+    {"forward", true, BAT_CHARGED, CENTER, CENTER, CENTER, HIGH_END, 400},
+    {"forward_left", true, BAT_CHARGED, HIGH_END, CENTER, CENTER, HIGH_END, 400},
+    {"forward_right", true, BAT_CHARGED, LOW_END, CENTER, CENTER, HIGH_END, 400},
+    {"backward", true, BAT_CHARGED, CENTER, CENTER, CENTER, LOW_END, 400},
+    {"backward_left", true, BAT_CHARGED, HIGH_END, CENTER, CENTER, LOW_END, 400},
+    {"backward_right", true, BAT_CHARGED, LOW_END, CENTER, CENTER, LOW_END, 400},
+    {"left", true, BAT_CHARGED, HIGH_END, CENTER, CENTER, CENTER, 400},
+    {"right", true, BAT_CHARGED, LOW_END, CENTER, CENTER, CENTER, 400},
+    {"pivot_forward", true, BAT_CHARGED, CENTER, HIGH_END, CENTER, CENTER, 400},
+    {"pivot_forward_left", true, BAT_CHARGED, CENTER, HIGH_END, HIGH_END, CENTER, 400},
+    {"pivot_forward_right", true, BAT_CHARGED, CENTER, HIGH_END, LOW_END, CENTER, 400},
+    {"pivot_backward", true, BAT_CHARGED, CENTER, LOW_END, CENTER, CENTER, 400},
+    {"pivot_backward_left", true, BAT_CHARGED, CENTER, LOW_END, HIGH_END, CENTER, 400},
+    {"pivot_backward_right", true, BAT_CHARGED, CENTER, LOW_END, LOW_END, CENTER, 400},
+    {"idle_no_packet", false, BAT_CHARGED, CENTER, CENTER, CENTER, CENTER, 400},
+    {"failsafe", false, BAT_CHARGED, CENTER, CENTER, CENTER, CENTER, 2500},
+    {"long_failsafe", false, BAT_CHARGED, CENTER, CENTER, CENTER, CENTER, 8000},
+    {"low_battery", true, BAT_DEPLETED, CENTER, CENTER, CENTER, HIGH_END, 1000},
+};
+const uint8_t NUMBER_SCENARIOS = sizeof(SCENARIOS) / sizeof(SCENARIOS[0]);
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Sequence Number of the Next Packet
+static uint8_t sequence = 0;
+
+// Runs One Loop Iteration with the Given Scenario Input
+static void step(const bench_scenario &scenario, bool mode_button)
+{
+  if (scenario.send_packets)
+  {
+    controller_variables packet;
+    memset(&packet, 0, sizeof(packet));
+    packet.button1_reading = mode_button;
+    packet.X1axis_reading = scenario.X1axis;
+    packet.Y1axis_reading = scenario.Y1axis;
+    packet.X2axis_reading = scenario.X2axis;
+    packet.Y2axis_reading = scenario.Y2axis;
+    radio_frame frame;
+    radio_frame_encode(packet, sequence++, frame);
+    native_radio_inject(&frame, sizeof(frame));
+#ifdef RADIO_IRQ_PIN
+    native_trigger_interrupt(digitalPinToInterrupt(RADIO_IRQ_PIN));
+#endif
+  }
+  native_set_analog(PIN_BAT, scenario.battery);
+  native_advance_micros(PACKET_PERIOD_US);
+  loop();
+}
+
+// Benchmarks One Scenario and Prints its Result Row
+static void run_scenario(const bench_scenario &scenario, bool mode_button, uint32_t iterations)
+{
+  // Settles Debounce, Failsafe and Battery Timers Before Measuring
+  uint32_t warmup = scenario.settle_ms * 1000UL / PACKET_PERIOD_US;
+  for (uint32_t i = 0; i < warmup; i++)
+  {
+    step(scenario, mode_button);
+  }
+
+  uint32_t writes_before = native_pin_writes();
+  uint32_t shows_before = native_led_shows(A0) + native_led_shows(A1);
+  uint32_t powered = 0;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iterations; i++)
+  {
+    step(scenario, mode_button);
+    powered += native_radio_powered() ? 1 : 0;
+  }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+  double seconds = std::chrono::duration<double>(end - start).count();
+  double writes = (double)(native_pin_writes() - writes_before) / iterations;
+  double shows = (double)(native_led_shows(A0) + native_led_shows(A1) - shows_before) / iterations;
+  printf("%-4s %-22s %14.0f %12.1f %12.2f %12.2f %10.1f\n", mode_button ? "2" : "1", scenario.name,
+         iterations / seconds, seconds * 1e9 / iterations, writes, shows, powered * 100.0 / iterations);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+  uint32_t iterations = 200000;
+  if (argc > 1)
+  {
+    iterations = strtoul(argv[1], NULL, 10);
+    if (iterations == 0)
+    {
+      fprintf(stderr, "usage: %s [iterations per scenario]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  native_reset();
+  native_set_analog(PIN_BAT, BAT_CHARGED);
+  setup();
+
+  printf("%-4s %-22s %14s %12s %12s %12s %10s\n", "mode", "scenario", "iter/s", "ns/iter", "pins/iter", "shows/iter",
+         "radio %");
+  for (uint8_t mode = 0; mode < 2; mode++)
+  {
+    for (uint8_t i = 0; i < NUMBER_SCENARIOS; i++)
+    {
+      run_scenario(SCENARIOS[i], mode == 1, iterations);
+    }
+  }
+  return 0;
+}
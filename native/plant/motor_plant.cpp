@@ -0,0 +1,83 @@
+// Host (Native) DC Motor and Mecanum Chassis Model
+#include <math.h>
+#include "motor_plant.h"
+
+// Chassis Geometry (60 mm Wheels, Half Wheelbase Plus Half Track)
+static const float WHEEL_RADIUS = 0.03f;
+static const float HALF_BASE = 0.16f;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Place a Robot at Rest
+void plant_begin(robot_plant &robot, const motor_parameters &motor)
+{
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    robot.wheels[i].motor = motor;
+    robot.wheels[i].speed = 0;
+    robot.wheels[i].edge_phase = 0;
+  }
+  robot.wheel_radius = WHEEL_RADIUS;
+  robot.half_base = HALF_BASE;
+  robot.x = 0;
+  robot.y = 0;
+  robot.heading = 0;
+}
+
+// Function to Advance One Wheel
+uint16_t plant_wheel_step(wheel_plant &wheel, float duty, float battery, float dt)
+{
+  const motor_parameters &motor = wheel.motor;
+
+  // Averaged Bridge Voltage, No Current Through a Disabled Bridge
+  float current = 0;
+  if (duty != 0)
+  {
+    float supply = battery - motor.bridge_drop;
+    supply = (supply > 0) ? supply : 0;
+    current = (duty * supply - motor.back_emf * wheel.speed) / motor.resistance;
+  }
+  float torque = motor.back_emf * current - motor.viscous * wheel.speed;
+
+  // Coulomb Friction Holds a Wheel at Rest Until the Torque Overcomes It
+  if (wheel.speed == 0 && fabsf(torque) <= motor.friction)
+  {
+    torque = 0;
+  }
+  else
+  {
+    float direction = (wheel.speed != 0) ? ((wheel.speed > 0) ? 1.0f : -1.0f) : ((torque > 0) ? 1.0f : -1.0f);
+    torque -= direction * motor.friction;
+  }
+  float speed = wheel.speed + torque / motor.inertia * dt;
+
+  // Friction Stops the Wheel Instead of Reversing It
+  if (wheel.speed != 0 && (speed > 0) != (wheel.speed > 0) && duty * wheel.speed >= 0)
+  {
+    speed = 0;
+  }
+  wheel.speed = speed;
+
+  // Encoder Edges Whatever the Direction
+  wheel.edge_phase += fabsf(wheel.speed) * motor.edges_per_rad * dt;
+  uint16_t edges = (uint16_t)wheel.edge_phase;
+  wheel.edge_phase -= edges;
+  return edges;
+}
+
+// Function to Move the Chassis (Inverse of the Mixer Equations)
+void plant_move(robot_plant &robot, float dt)
+{
+  const float fl = robot.wheels[0].speed;
+  const float fr = robot.wheels[1].speed;
+  const float bl = robot.wheels[2].speed;
+  const float br = robot.wheels[3].speed;
+  const float forward = robot.wheel_radius * (fl + fr + bl + br) / 4;
+  const float left = robot.wheel_radius * (-fl + fr + bl - br) / 4;
+  const float turn = robot.wheel_radius * (-fl + fr - bl + br) / (4 * robot.half_base);
+
+  robot.heading += turn * dt;
+  robot.x += (forward * cosf(robot.heading) - left * sinf(robot.heading)) * dt;
+  robot.y += (forward * sinf(robot.heading) + left * cosf(robot.heading)) * dt;
+}
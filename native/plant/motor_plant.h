@@ -0,0 +1,60 @@
+// Host (Native) DC Motor and Mecanum Chassis Model
+#pragma once
+
+#include <stdint.h>
+
+/***********************************************************************************************************************
+ *
+ *  A simulated robot for host programs: four geared DC motors behind the L298P, each with its own load, turning
+ *  mecanum wheels whose speeds move the chassis through the forward kinematics of the mixer. Motors are modelled on
+ *  the averaged PWM voltage (battery less the bridge drop, times the duty) against back EMF through the winding
+ *  resistance, with Coulomb and viscous friction standing for the gearbox and the surface under the wheel. A disabled
+ *  bridge (duty 0) lets the motor coast. Each wheel also produces the edges of a single channel encoder counted on
+ *  both edges.
+ *
+ *  Units are SI at the wheel (after the gearbox): volts, ohms, V.s/rad (equal to N.m/A), kg.m^2, N.m, rad/s, meters.
+ *
+ **********************************************************************************************************************/
+
+// Motor and Load of One Wheel
+typedef struct
+{
+  float resistance;
+  float back_emf;
+  float bridge_drop;
+  float inertia;
+  float friction;
+  float viscous;
+  float edges_per_rad;
+} motor_parameters;
+
+// Geared Motor Spinning 31 rad/s (3300 Encoder Edges/s) Unloaded at Full Duty on 8.2 V
+const motor_parameters MOTOR_DEFAULT = {3.0f, 0.2165f, 1.4f, 0.0005f, 0.02f, 0.0005f, 105.0f};
+
+// Simulated Wheel
+typedef struct
+{
+  motor_parameters motor;
+  float speed;
+  float edge_phase;
+} wheel_plant;
+
+// Simulated Robot (Wheels in the Drive Command Order, Pose in the Start Frame, Heading Counterclockwise)
+typedef struct
+{
+  wheel_plant wheels[4];
+  float wheel_radius;
+  float half_base;
+  float x;
+  float y;
+  float heading;
+} robot_plant;
+
+// Places a Robot at Rest at the Origin, All Wheels With the Same Motor
+void plant_begin(robot_plant &robot, const motor_parameters &motor);
+
+// Advances One Wheel by dt Seconds Under a Signed Duty (-1..1), Returns the Encoder Edges it Produced
+uint16_t plant_wheel_step(wheel_plant &wheel, float duty, float battery, float dt);
+
+// Moves the Chassis by dt Seconds at the Current Wheel Speeds
+void plant_move(robot_plant &robot, float dt);
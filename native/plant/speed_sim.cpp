@@ -0,0 +1,241 @@
+// Host (Native) Closed Loop Wheel Speed Simulation
+#include <Arduino.h>
+#include <math.h>
+#include <stdio.h>
+#include "native_hal.h"
+#include "controller.h"
+#include "radio_frame.h"
+#include "motor_driver.h"
+#include "encoders.h"
+#include "speed_control.h"
+#include "battery.h"
+#include "motor_plant.h"
+
+/***********************************************************************************************************************
+ *
+ *  Runs the unmodified setup()/loop() of src/main.cpp against the motor and chassis model of motor_plant.h: the wheel
+ *  duties and directions the firmware writes drive the simulated motors, whose encoder edges come back through the
+ *  encoder interrupts. Every scenario (a stick command on a given battery and surface) runs open loop and then with
+ *  the given gains, and reports the spread between the wheel speeds and how far the robot ended up from the path of
+ *  the first scenario, the reference run on an even floor with a full battery.
+ *
+ *  Usage: program [kp ki kd]   (Q8 gains, defaults to SPEED_GAINS_DEFAULT)
+ *
+ **********************************************************************************************************************/
+
+// Firmware Entry Points
+void setup();
+void loop();
+
+// Simulation Parameters
+const uint8_t PIN_BAT = A3;
+const uint32_t STEP_US = 100;
+const uint32_t PACKET_PERIOD_US = 20000;
+const uint32_t RUN_US = 3000000;
+const uint32_t REST_US = 15000000;
+
+// Stick Positions
+const uint16_t CENTER = 512;
+const uint16_t HIGH_END = 1023;
+
+// Wheel Pins and Encoder Interrupts in Drive Command Order
+typedef struct
+{
+  uint8_t dir;
+  uint8_t en;
+  uint8_t encoder;
+} wheel_pins;
+const wheel_pins WHEELS[NUMBER_WHEELS] = {
+    {PIN_DIRB, PIN_ENB, ENCODER_PIN_FRONT_LEFT},
+    {PIN_DIRD, PIN_END, ENCODER_PIN_FRONT_RIGHT},
+    {PIN_DIRA, PIN_ENA, ENCODER_PIN_BACK_LEFT},
+    {PIN_DIRC, PIN_ENC, ENCODER_PIN_BACK_RIGHT},
+};
+
+// Load Multipliers of Each Wheel (Friction, Viscous)
+typedef struct
+{
+  float friction[NUMBER_WHEELS];
+  float viscous[NUMBER_WHEELS];
+} surface;
+const surface EVEN = {{1, 1, 1, 1}, {1, 1, 1, 1}};
+const surface CARPET_RIGHT = {{1, 2.5f, 1, 2.5f}, {1, 3, 1, 3}};
+const surface STIFF_BACK_LEFT = {{1, 1, 3, 1}, {1, 1, 2, 1}};
+
+// Simulation Scenarios
+typedef struct
+{
+  const char *name;
+  uint16_t X2axis;
+  uint16_t Y2axis;
+  float battery;
+  const surface *floor;
+} sim_scenario;
+
+const sim_scenario SCENARIOS[] = {
+    {"strafe_left", HIGH_END, CENTER, 8.2f, &EVEN},
+    {"strafe_left_low_battery", HIGH_END, CENTER, 7.0f, &EVEN},
+    {"strafe_left_carpet_right", HIGH_END, CENTER, 8.2f, &CARPET_RIGHT},
+    {"strafe_left_stiff_wheel", HIGH_END, CENTER, 8.2f, &STIFF_BACK_LEFT},
+    {"forward", CENTER, HIGH_END, 8.2f, &EVEN},
+    {"forward_low_battery", CENTER, HIGH_END, 7.0f, &EVEN},
+    {"forward_carpet_right", CENTER, HIGH_END, 8.2f, &CARPET_RIGHT},
+};
+const uint8_t NUMBER_SCENARIOS = sizeof(SCENARIOS) / sizeof(SCENARIOS[0]);
+
+// Outcome of One Run
+typedef struct
+{
+  float x;
+  float y;
+  float heading;
+  float spread;
+} sim_result;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Send a Packet to the Firmware
+static void send_packet(const controller_variables &controller)
+{
+  static uint8_t sequence = 0;
+  radio_frame frame;
+  radio_frame_encode(controller, sequence++, frame);
+  native_radio_inject(&frame, sizeof(frame));
+#ifdef RADIO_IRQ_PIN
+  native_trigger_interrupt(digitalPinToInterrupt(RADIO_IRQ_PIN));
+#endif
+}
+
+// Function to Advance the Firmware and the Plant by One Step
+static void step(robot_plant &robot, float battery)
+{
+  native_advance_micros(STEP_US);
+  loop();
+
+  for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+  {
+    // Direction Pin Low Drives the Wheel Forward
+    float duty = native_pin_pwm(WHEELS[i].en) / 255.0f;
+    duty = native_pin_level(WHEELS[i].dir) ? -duty : duty;
+    uint16_t edges = plant_wheel_step(robot.wheels[i], duty, battery, STEP_US * 1e-6f);
+    int8_t interrupt = digitalPinToInterrupt(WHEELS[i].encoder);
+    for (uint16_t e = 0; e < edges && interrupt >= 0; e++)
+    {
+      native_trigger_interrupt(interrupt);
+    }
+  }
+  plant_move(robot, STEP_US * 1e-6f);
+}
+
+// Function to Run One Scenario with the Given Gains
+static sim_result run(const sim_scenario &scenario, const speed_gains &gains)
+{
+  // Firmware Comes to Rest (and the Host Battery Filters Settle) Before the Robot is Placed Back at the Origin
+  robot_plant robot;
+  plant_begin(robot, MOTOR_DEFAULT);
+  for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+  {
+    robot.wheels[i].motor.friction *= scenario.floor->friction[i];
+    robot.wheels[i].motor.viscous *= scenario.floor->viscous[i];
+  }
+  native_set_analog(PIN_BAT, battery_counts(scenario.battery) >> BATTERY_FILTER_SHIFT);
+  controller_variables controller;
+  memset(&controller, 0, sizeof(controller));
+  controller.X1axis_reading = CENTER;
+  controller.Y1axis_reading = CENTER;
+  controller.X2axis_reading = CENTER;
+  controller.Y2axis_reading = CENTER;
+  controller.slider1_reading = CENTER;
+  controller.slider2_reading = CENTER;
+
+  // Sticks Held Centered Meanwhile, So the Link Stays Up and the Robot Never Goes Idle
+  for (uint32_t t = 0; t < REST_US; t += STEP_US)
+  {
+    if (t % PACKET_PERIOD_US == 0)
+    {
+      send_packet(controller);
+    }
+    native_advance_micros(STEP_US);
+    loop();
+  }
+  speed_control_configure(gains);
+  controller.X2axis_reading = scenario.X2axis;
+  controller.Y2axis_reading = scenario.Y2axis;
+
+  // Wheel Speed Spread Averaged Over the Second Half of the Run
+  double spread = 0;
+  uint32_t samples = 0;
+  for (uint32_t t = 0; t < RUN_US; t += STEP_US)
+  {
+    if (t % PACKET_PERIOD_US == 0)
+    {
+      send_packet(controller);
+    }
+    step(robot, scenario.battery);
+
+    if (t >= RUN_US / 2)
+    {
+      float low = fabsf(robot.wheels[0].speed);
+      float high = low;
+      for (uint8_t i = 1; i < NUMBER_WHEELS; i++)
+      {
+        low = fminf(low, fabsf(robot.wheels[i].speed));
+        high = fmaxf(high, fabsf(robot.wheels[i].speed));
+      }
+      spread += (high > 0) ? (high - low) / high : 0;
+      samples++;
+    }
+  }
+
+  sim_result result = {robot.x, robot.y, robot.heading, (float)(spread / samples)};
+  return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+  speed_gains gains = SPEED_GAINS_DEFAULT;
+  if (argc == 4)
+  {
+    gains.kp = atoi(argv[1]);
+    gains.ki = atoi(argv[2]);
+    gains.kd = atoi(argv[3]);
+  }
+  else if (argc != 1)
+  {
+    fprintf(stderr, "usage: %s [kp ki kd]\n", argv[0]);
+    return 2;
+  }
+
+  native_reset();
+  native_set_analog(PIN_BAT, battery_counts(8.2f) >> BATTERY_FILTER_SHIFT);
+  setup();
+
+  printf("Gains kp %u ki %u kd %u (Q8), %.1f s runs, path error against the reference run of each stick command\n",
+         gains.kp, gains.ki, gains.kd, RUN_US / 1e6);
+  printf("%-26s %-7s %9s %9s %9s %9s %11s\n", "scenario", "loop", "x (cm)", "y (cm)", "head (deg)", "spread %",
+         "error (cm)");
+
+  sim_result reference[2];
+  for (uint8_t s = 0; s < NUMBER_SCENARIOS; s++)
+  {
+    const sim_scenario &scenario = SCENARIOS[s];
+    for (uint8_t closed = 0; closed < 2; closed++)
+    {
+      sim_result result = run(scenario, closed ? gains : SPEED_GAINS_OPEN);
+
+      // Each Stick Command's First Scenario is the Reference of the Following Ones
+      if (s == 0 || scenario.X2axis != SCENARIOS[s - 1].X2axis)
+      {
+        reference[closed] = result;
+      }
+      float error = hypotf(result.x - reference[closed].x, result.y - reference[closed].y);
+      printf("%-26s %-7s %9.1f %9.1f %9.1f %9.1f %11.1f\n", scenario.name, closed ? "closed" : "open", result.x * 100,
+             result.y * 100, result.heading * 180 / M_PI, result.spread * 100, error * 100);
+    }
+  }
+  return 0;
+}
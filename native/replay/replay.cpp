@@ -0,0 +1,336 @@
+// Host (Native) Replay of Captured Controller Streams
+#include <Arduino.h>
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "native_hal.h"
+#include "controller.h"
+#include "radio_frame.h"
+#include "motor_driver.h"
+#include "capture.h"
+
+/***********************************************************************************************************************
+ *
+ *  Feeds a capture (see capture.h) through the unmodified setup()/loop() of src/main.cpp, each packet injected into
+ *  the radio at its captured time, and traces what the firmware drives: the signed PWM of the four wheels, the buzzer,
+ *  the builtin LED and the colors shown on both LED strips. A trace row is written every time one of them changes, so
+ *  traces are short and diff cleanly. Given a golden trace, the replay compares against it and fails on the first
+ *  differing rows; either way it reports its throughput.
+ *
+ *  Usage: program <capture.csv> [--trace <out.csv>] [--golden <golden.csv>] [--step-us <loop period>]
+ *
+ **********************************************************************************************************************/
+
+// Firmware Entry Points
+void setup();
+void loop();
+
+// Simulated Hardware Parameters
+const uint8_t PIN_BAT = A3;
+const uint8_t PIN_BUZZER = A2;
+const uint8_t PIN_LED_FRONT = A1;
+const uint8_t PIN_LED_BACK = A0;
+const uint8_t NUMBER_LED = 8;
+const uint16_t BAT_DEFAULT = 328; // ~8.0 V through the 30k/7.5k divider
+
+// Time Replayed After the Last Packet (Lets the Failsafe Tiers Play Out)
+const uint32_t TAIL_US = 500000;
+
+// Mismatching Rows Reported Before Giving Up
+const uint8_t MISMATCHES_SHOWN = 5;
+
+// Wheel Pins in Trace Column Order
+typedef struct
+{
+  const char *name;
+  uint8_t dir;
+  uint8_t en;
+} wheel_pins;
+const wheel_pins WHEELS[] = {
+    {"front_left", PIN_DIRB, PIN_ENB},
+    {"front_right", PIN_DIRD, PIN_END},
+    {"back_left", PIN_DIRA, PIN_ENA},
+    {"back_right", PIN_DIRC, PIN_ENC},
+};
+
+// Captured Packet
+typedef struct
+{
+  uint32_t time_us;
+  uint8_t sequence;
+  controller_variables controller;
+  uint16_t battery;
+} capture_record;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Load a Capture, False on Any Malformed Line
+static bool load_capture(const char *path, std::vector<capture_record> &records)
+{
+  FILE *file = fopen(path, "r");
+  if (file == NULL)
+  {
+    fprintf(stderr, "cannot open %s\n", path);
+    return false;
+  }
+
+  char line[256];
+  uint32_t number = 0;
+  while (fgets(line, sizeof(line), file) != NULL)
+  {
+    number++;
+    if (number == 1 && strncmp(line, CAPTURE_MAGIC, strlen(CAPTURE_MAGIC)) != 0)
+    {
+      fprintf(stderr, "%s: not a capture (first line is not \"%s\")\n", path, CAPTURE_MAGIC);
+      fclose(file);
+      return false;
+    }
+    if (line[0] == '#' || line[0] == '\n' || strncmp(line, CAPTURE_COLUMNS, strlen(CAPTURE_COLUMNS)) == 0)
+    {
+      continue;
+    }
+
+    unsigned long time_us;
+    unsigned int fields[14];
+    int parsed = sscanf(line, "%lu,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u", &time_us, &fields[0], &fields[1],
+                        &fields[2], &fields[3], &fields[4], &fields[5], &fields[6], &fields[7], &fields[8], &fields[9],
+                        &fields[10], &fields[11], &fields[12], &fields[13]);
+    if (parsed != 15)
+    {
+      fprintf(stderr, "%s:%u: expected 15 fields\n", path, number);
+      fclose(file);
+      return false;
+    }
+
+    capture_record record;
+    record.time_us = time_us;
+    record.sequence = fields[0];
+    record.controller.button1_reading = fields[1];
+    record.controller.button2_reading = fields[2];
+    record.controller.button3_reading = fields[3];
+    record.controller.button4_reading = fields[4];
+    record.controller.button5_reading = fields[5];
+    record.controller.button6_reading = fields[6];
+    record.controller.X1axis_reading = fields[7];
+    record.controller.Y1axis_reading = fields[8];
+    record.controller.X2axis_reading = fields[9];
+    record.controller.Y2axis_reading = fields[10];
+    record.controller.slider1_reading = fields[11];
+    record.controller.slider2_reading = fields[12];
+    record.battery = fields[13];
+    if (!records.empty() && record.time_us < records.back().time_us)
+    {
+      fprintf(stderr, "%s:%u: time goes backwards\n", path, number);
+      fclose(file);
+      return false;
+    }
+    records.push_back(record);
+  }
+  fclose(file);
+  return true;
+}
+
+// Function to Format the Traced Outputs (Without the Time Column)
+static std::string trace_outputs(void)
+{
+  char row[256];
+  int length = 0;
+  for (uint8_t i = 0; i < sizeof(WHEELS) / sizeof(WHEELS[0]); i++)
+  {
+    // Direction Pin Low Drives the Wheel Forward
+    int pwm = native_pin_pwm(WHEELS[i].en);
+    length += snprintf(&row[length], sizeof(row) - length, "%d,", native_pin_level(WHEELS[i].dir) ? -pwm : pwm);
+  }
+  length += snprintf(&row[length], sizeof(row) - length, "%u,%u,", native_pin_level(PIN_BUZZER),
+                     native_pin_level(LED_BUILTIN));
+  const uint8_t strips[2] = {PIN_LED_FRONT, PIN_LED_BACK};
+  for (uint8_t s = 0; s < 2; s++)
+  {
+    for (uint8_t i = 0; i < NUMBER_LED; i++)
+    {
+      length += snprintf(&row[length], sizeof(row) - length, "%06x", (unsigned)native_led_color(strips[s], i));
+    }
+    row[length++] = (s == 0) ? ',' : '\0';
+  }
+  return std::string(row);
+}
+
+// Function to Load a Golden Trace
+static bool load_trace(const char *path, std::vector<std::string> &rows)
+{
+  FILE *file = fopen(path, "r");
+  if (file == NULL)
+  {
+    fprintf(stderr, "cannot open %s\n", path);
+    return false;
+  }
+  char line[512];
+  while (fgets(line, sizeof(line), file) != NULL)
+  {
+    line[strcspn(line, "\r\n")] = '\0';
+    rows.push_back(line);
+  }
+  fclose(file);
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+  const char *capture_path = NULL;
+  const char *trace_path = NULL;
+  const char *golden_path = NULL;
+  uint32_t step_us = 500;
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+    {
+      trace_path = argv[++i];
+    }
+    else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc)
+    {
+      golden_path = argv[++i];
+    }
+    else if (strcmp(argv[i], "--step-us") == 0 && i + 1 < argc)
+    {
+      step_us = strtoul(argv[++i], NULL, 10);
+    }
+    else if (capture_path == NULL && argv[i][0] != '-')
+    {
+      capture_path = argv[i];
+    }
+    else
+    {
+      capture_path = NULL;
+      break;
+    }
+  }
+  if (capture_path == NULL || step_us == 0)
+  {
+    fprintf(stderr, "usage: %s <capture.csv> [--trace <out.csv>] [--golden <golden.csv>] [--step-us <period>]\n",
+            argv[0]);
+    return 2;
+  }
+
+  std::vector<capture_record> records;
+  if (!load_capture(capture_path, records) || records.empty())
+  {
+    fprintf(stderr, "%s: no packets to replay\n", capture_path);
+    return 2;
+  }
+
+  // Header Row
+  std::vector<std::string> trace;
+  std::string header = "time_us";
+  for (uint8_t i = 0; i < sizeof(WHEELS) / sizeof(WHEELS[0]); i++)
+  {
+    header += std::string(",") + WHEELS[i].name;
+  }
+  header += ",buzzer,led_builtin,front_leds,back_leds";
+  trace.push_back(header);
+
+  // Starts the Firmware on the Battery of the First Packet, Packet Times Relative to the First One
+  native_reset();
+  native_set_analog(PIN_BAT, records[0].battery ? records[0].battery : BAT_DEFAULT);
+  setup();
+  const uint64_t origin = native_time_micros();
+  const uint32_t first_time = records[0].time_us;
+  const uint32_t duration = records.back().time_us - first_time + TAIL_US;
+
+  size_t next = 0;
+  uint32_t iterations = 0;
+  std::string last_outputs;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (uint32_t now = 0; now <= duration; now += step_us)
+  {
+    // Packets Due by Now
+    while (next < records.size() && records[next].time_us - first_time <= now)
+    {
+      const capture_record &record = records[next++];
+      radio_frame frame;
+      radio_frame_encode(record.controller, record.sequence, frame);
+      native_radio_inject(&frame, sizeof(frame));
+      if (record.battery != 0)
+      {
+        native_set_analog(PIN_BAT, record.battery);
+      }
+#ifdef RADIO_IRQ_PIN
+      native_trigger_interrupt(digitalPinToInterrupt(RADIO_IRQ_PIN));
+#endif
+    }
+
+    // The Firmware May Have Moved the Clock Itself Through delay()
+    if (origin + now > native_time_micros())
+    {
+      native_advance_micros(origin + now - native_time_micros());
+    }
+    loop();
+    iterations++;
+
+    std::string outputs = trace_outputs();
+    if (outputs != last_outputs)
+    {
+      trace.push_back(std::to_string(now) + "," + outputs);
+      last_outputs = outputs;
+    }
+  }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+  // Trace Output
+  if (trace_path != NULL)
+  {
+    FILE *file = fopen(trace_path, "w");
+    if (file == NULL)
+    {
+      fprintf(stderr, "cannot write %s\n", trace_path);
+      return 2;
+    }
+    for (size_t i = 0; i < trace.size(); i++)
+    {
+      fprintf(file, "%s\n", trace[i].c_str());
+    }
+    fclose(file);
+  }
+
+  // Throughput
+  double seconds = std::chrono::duration<double>(end - start).count();
+  printf("%s: %zu packets, %u loop iterations, %.3f s replayed in %.1f ms (%.0f iter/s, %.0fx real time)\n",
+         capture_path, records.size(), iterations, duration / 1e6, seconds * 1e3, iterations / seconds,
+         duration / 1e6 / seconds);
+
+  // Golden Comparison
+  if (golden_path != NULL)
+  {
+    std::vector<std::string> golden;
+    if (!load_trace(golden_path, golden))
+    {
+      return 2;
+    }
+    uint32_t mismatches = 0;
+    size_t rows = (trace.size() > golden.size()) ? trace.size() : golden.size();
+    for (size_t i = 0; i < rows; i++)
+    {
+      const std::string &expected = (i < golden.size()) ? golden[i] : std::string("<missing>");
+      const std::string &actual = (i < trace.size()) ? trace[i] : std::string("<missing>");
+      if (expected != actual)
+      {
+        if (mismatches < MISMATCHES_SHOWN)
+        {
+          printf("  row %zu\n    golden: %s\n    replay: %s\n", i + 1, expected.c_str(), actual.c_str());
+        }
+        mismatches++;
+      }
+    }
+    if (mismatches > 0)
+    {
+      printf("%s: %u rows differ from %s\n", capture_path, mismatches, golden_path);
+      return 1;
+    }
+    printf("%s: matches %s (%zu rows)\n", capture_path, golden_path, trace.size());
+  }
+  return 0;
+}
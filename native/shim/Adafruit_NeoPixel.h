@@ -0,0 +1,45 @@
+// Adafruit NeoPixel Library Shim for Host (Native) Builds
+#pragma once
+
+/***********************************************************************************************************************
+ *
+ *  Keeps the pixel buffer in RAM like the real library does and counts show() calls, so the harness can observe both
+ *  the rendered frame and how often the strip would have been refreshed.
+ *
+ **********************************************************************************************************************/
+
+#include <Arduino.h>
+
+// Pixel Color Order and Speed Flags
+#define NEO_GRB ((1 << 6) | (1 << 4) | (0 << 2) | (2))
+#define NEO_RGB ((0 << 6) | (0 << 4) | (1 << 2) | (2))
+#define NEO_KHZ800 0x0000
+
+// LEDs Module Control Object
+class Adafruit_NeoPixel
+{
+public:
+  Adafruit_NeoPixel(uint16_t n, int16_t pin, uint16_t type);
+  ~Adafruit_NeoPixel(void);
+
+  void begin(void);
+  void show(void);
+  void clear(void);
+  void setPixelColor(uint16_t n, uint32_t c);
+  void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b);
+  void setBrightness(uint8_t b);
+  uint32_t getPixelColor(uint16_t n) const;
+  uint16_t numPixels(void) const { return num_leds; }
+  int16_t getPin(void) const { return pin; }
+  uint32_t showCount(void) const { return show_count; }
+  static uint32_t Color(uint8_t r, uint8_t g, uint8_t b)
+  {
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+  }
+
+private:
+  uint16_t num_leds;
+  int16_t pin;
+  uint32_t *pixels;
+  uint32_t show_count;
+};
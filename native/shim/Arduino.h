@@ -0,0 +1,106 @@
+// Arduino Framework Shim for Host (Native) Builds
+#pragma once
+
+/***********************************************************************************************************************
+ *
+ *  Minimal subset of the Arduino core API used by the robot firmware, implemented on top of a simulated clock and a
+ *  simulated pin table so that src/main.cpp compiles and runs unmodified on Linux. Pin numbers follow the Arduino
+ *  Leonardo (ATmega32u4) numbering. The test harness side of the shim lives in native_hal.h.
+ *
+ **********************************************************************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Arduino Types
+typedef uint8_t byte;
+typedef bool boolean;
+
+// Digital Levels and Pin Modes
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+// Interrupt Modes
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+// Arduino Leonardo Pin Numbers
+#define NUM_DIGITAL_PINS 31
+#define LED_BUILTIN 13
+#define A0 18
+#define A1 19
+#define A2 20
+#define A3 21
+#define A4 22
+#define A5 23
+
+// Flash String Helpers (No Separate Flash Space on the Host)
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr) (*(void *const *)(addr))
+#define memcpy_P(dest, src, n) memcpy((dest), (src), (n))
+
+// Math Helpers
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+// Digital and Analog I/O
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+
+// Time
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// Interrupts
+#define digitalPinToInterrupt(p) ((p) == 3 ? 0 : ((p) == 2 ? 1 : ((p) == 0 ? 2 : ((p) == 1 ? 3 : ((p) == 7 ? 4 : -1)))))
+void attachInterrupt(uint8_t interrupt_number, void (*handler)(void), int mode);
+void detachInterrupt(uint8_t interrupt_number);
+void interrupts(void);
+void noInterrupts(void);
+
+// Serial Port Shim (Output is Discarded Unless a Sink is Set Through native_hal.h)
+class NativeSerial
+{
+public:
+  void begin(unsigned long baud);
+  void end(void);
+  operator bool(void) const { return true; }
+  int available(void);
+  int read(void);
+  size_t write(uint8_t value);
+  size_t write(const uint8_t *buffer, size_t size);
+  size_t print(const char *value);
+  size_t print(const __FlashStringHelper *value);
+  size_t print(char value);
+  size_t print(int value);
+  size_t print(unsigned int value);
+  size_t print(long value);
+  size_t print(unsigned long value);
+  size_t print(double value, int digits = 2);
+  size_t println(void);
+  template <typename T>
+  size_t println(T value)
+  {
+    size_t n = print(value);
+    return n + println();
+  }
+};
+extern NativeSerial Serial;
@@ -0,0 +1,44 @@
+// EEPROM Library Shim for Host (Native) Builds
+#pragma once
+
+/***********************************************************************************************************************
+ *
+ *  Stand-in for the AVR EEPROM library over the 1 KB of the ATmega32u4. It starts erased (all 0xFF) and, like the real
+ *  one, keeps its contents across native_reset(); harnesses erase it with native_eeprom_erase().
+ *
+ **********************************************************************************************************************/
+
+#include <Arduino.h>
+
+class EEPROMClass
+{
+public:
+  EEPROMClass(void);
+  uint8_t read(int index);
+  void write(int index, uint8_t value);
+  void update(int index, uint8_t value);
+  uint16_t length(void);
+
+  template <typename T>
+  T &get(int index, T &value)
+  {
+    uint8_t *bytes = (uint8_t *)&value;
+    for (uint16_t i = 0; i < sizeof(T); i++)
+    {
+      bytes[i] = read(index + i);
+    }
+    return value;
+  }
+
+  template <typename T>
+  const T &put(int index, const T &value)
+  {
+    const uint8_t *bytes = (const uint8_t *)&value;
+    for (uint16_t i = 0; i < sizeof(T); i++)
+    {
+      update(index + i, bytes[i]);
+    }
+    return value;
+  }
+};
+extern EEPROMClass EEPROM;
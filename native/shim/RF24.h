@@ -0,0 +1,71 @@
+// RF24 Library Shim for Host (Native) Builds
+#pragma once
+
+/***********************************************************************************************************************
+ *
+ *  Stand-in for the nRF24L01 driver. Payloads are injected by the harness through native_hal.h and handed to the
+ *  firmware in FIFO order through available()/read(), the same way the real RX FIFO would deliver them.
+ *
+ **********************************************************************************************************************/
+
+#include <Arduino.h>
+
+// Power Amplifier Levels
+typedef enum
+{
+  RF24_PA_MIN = 0,
+  RF24_PA_LOW,
+  RF24_PA_HIGH,
+  RF24_PA_MAX,
+  RF24_PA_ERROR
+} rf24_pa_dbm_e;
+
+// Air Data Rates
+typedef enum
+{
+  RF24_1MBPS = 0,
+  RF24_2MBPS,
+  RF24_250KBPS
+} rf24_datarate_e;
+
+// Radio Controller Object
+class RF24
+{
+public:
+  RF24(uint16_t ce_pin, uint16_t csn_pin);
+
+  bool begin(void);
+  bool isChipConnected(void);
+  void setPALevel(uint8_t level, bool lna_enable = true);
+  uint8_t getPALevel(void);
+  bool setDataRate(rf24_datarate_e speed);
+  rf24_datarate_e getDataRate(void);
+  void setChannel(uint8_t channel);
+  uint8_t getChannel(void);
+  void setPayloadSize(uint8_t size);
+  uint8_t getPayloadSize(void);
+  void openWritingPipe(const uint8_t *address);
+  void openReadingPipe(uint8_t number, const uint8_t *address);
+  void startListening(void);
+  void stopListening(void);
+  bool available(void);
+  bool available(uint8_t *pipe_num);
+  void read(void *buf, uint8_t len);
+  void enableDynamicPayloads(void);
+  void enableAckPayload(void);
+  uint8_t getDynamicPayloadSize(void);
+  bool writeAckPayload(uint8_t pipe, const void *buf, uint8_t len);
+  uint8_t flush_tx(void);
+  uint8_t flush_rx(void);
+  bool testRPD(void);
+  void powerDown(void);
+  void powerUp(void);
+  void maskIRQ(bool tx_ok, bool tx_fail, bool rx_ready);
+  void whatHappened(bool &tx_ok, bool &tx_fail, bool &rx_ready);
+
+private:
+  uint8_t pa_level;
+  uint8_t payload_size;
+  uint8_t channel;
+  rf24_datarate_e data_rate;
+};
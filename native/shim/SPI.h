@@ -0,0 +1,4 @@
+// SPI Library Shim for Host (Native) Builds
+#pragma once
+
+#include <Arduino.h>
@@ -0,0 +1,662 @@
+// Host (Native) Implementation of the Arduino, RF24, NeoPixel and EEPROM Shims
+#include <Arduino.h>
+#include <RF24.h>
+#include <Adafruit_NeoPixel.h>
+#include <EEPROM.h>
+#include "native_hal.h"
+
+/***********************************************************************************************************************
+ *
+ *  All simulated hardware state lives in this file. Nothing here touches the real clock: time only moves when the
+ *  harness calls native_advance_micros() or when the firmware calls delay()/delayMicroseconds().
+ *
+ **********************************************************************************************************************/
+
+// Simulated Clock
+static uint64_t time_us = 0;
+
+// Simulated Pins
+static uint8_t pin_modes[NUM_DIGITAL_PINS];
+static uint8_t pin_levels[NUM_DIGITAL_PINS];
+static int pin_pwms[NUM_DIGITAL_PINS];
+static uint16_t analog_values[NUM_DIGITAL_PINS];
+static uint32_t pin_writes = 0;
+
+// Simulated Interrupts
+static const uint8_t NUMBER_INTERRUPTS = 5;
+static void (*interrupt_handlers[NUMBER_INTERRUPTS])(void);
+
+// Simulated Radio
+static const uint8_t RADIO_QUEUE_SIZE = 32;
+static const uint8_t RADIO_PAYLOAD_MAX = 32;
+static uint8_t radio_queue[RADIO_QUEUE_SIZE][RADIO_PAYLOAD_MAX];
+static uint8_t radio_lengths[RADIO_QUEUE_SIZE];
+static uint8_t radio_head = 0;
+static uint8_t radio_count = 0;
+static bool radio_begin_ok = true;
+static bool radio_powered = false;
+static uint8_t radio_channel = 76;
+static uint8_t radio_data_rate = RF24_1MBPS;
+static uint8_t radio_pa_level = RF24_PA_MAX;
+static const uint8_t RADIO_ACK_FIFO_SIZE = 3;
+static uint8_t radio_ack[RADIO_PAYLOAD_MAX];
+static uint8_t radio_ack_length = 0;
+static uint8_t radio_ack_count = 0;
+static const uint8_t RADIO_CHANNELS = 126;
+static bool radio_noise[RADIO_CHANNELS];
+
+// Simulated LED Strips
+static const uint8_t NUMBER_STRIPS = 8;
+static const uint16_t STRIP_LEDS_MAX = 64;
+typedef struct
+{
+  const Adafruit_NeoPixel *strip;
+  int16_t pin;
+  uint32_t shown[STRIP_LEDS_MAX];
+} strip_record;
+static strip_record strips[NUMBER_STRIPS];
+
+// Simulated EEPROM
+static const uint16_t EEPROM_SIZE = 1024;
+static uint8_t eeprom[EEPROM_SIZE];
+static uint32_t eeprom_writes = 0;
+EEPROMClass EEPROM;
+
+// Serial Output Sink
+static FILE *serial_sink = NULL;
+NativeSerial Serial;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Arduino Core Functions
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  if (pin < NUM_DIGITAL_PINS)
+  {
+    pin_modes[pin] = mode;
+  }
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+  if (pin < NUM_DIGITAL_PINS)
+  {
+    pin_levels[pin] = val ? HIGH : LOW;
+    pin_pwms[pin] = val ? 255 : 0;
+    pin_writes++;
+  }
+}
+
+int digitalRead(uint8_t pin)
+{
+  return (pin < NUM_DIGITAL_PINS) ? pin_levels[pin] : LOW;
+}
+
+int analogRead(uint8_t pin)
+{
+  return (pin < NUM_DIGITAL_PINS) ? analog_values[pin] : 0;
+}
+
+void analogWrite(uint8_t pin, int val)
+{
+  if (pin < NUM_DIGITAL_PINS)
+  {
+    pin_pwms[pin] = val;
+    pin_levels[pin] = (val > 127) ? HIGH : LOW;
+    pin_writes++;
+  }
+}
+
+unsigned long millis(void)
+{
+  return (unsigned long)(time_us / 1000);
+}
+
+unsigned long micros(void)
+{
+  return (unsigned long)time_us;
+}
+
+void delay(unsigned long ms)
+{
+  time_us += (uint64_t)ms * 1000;
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  time_us += us;
+}
+
+void attachInterrupt(uint8_t interrupt_number, void (*handler)(void), int mode)
+{
+  (void)mode;
+  if (interrupt_number < NUMBER_INTERRUPTS)
+  {
+    interrupt_handlers[interrupt_number] = handler;
+  }
+}
+
+void detachInterrupt(uint8_t interrupt_number)
+{
+  if (interrupt_number < NUMBER_INTERRUPTS)
+  {
+    interrupt_handlers[interrupt_number] = NULL;
+  }
+}
+
+void interrupts(void) {}
+void noInterrupts(void) {}
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Serial Port Shim
+void NativeSerial::begin(unsigned long baud) { (void)baud; }
+void NativeSerial::end(void) {}
+int NativeSerial::available(void) { return 0; }
+int NativeSerial::read(void) { return -1; }
+
+size_t NativeSerial::write(uint8_t value)
+{
+  return write(&value, 1);
+}
+
+size_t NativeSerial::write(const uint8_t *buffer, size_t size)
+{
+  if (serial_sink != NULL)
+  {
+    fwrite(buffer, 1, size, serial_sink);
+  }
+  return size;
+}
+
+size_t NativeSerial::print(const char *value)
+{
+  return write((const uint8_t *)value, strlen(value));
+}
+
+size_t NativeSerial::print(const __FlashStringHelper *value)
+{
+  return print(reinterpret_cast<const char *>(value));
+}
+
+size_t NativeSerial::print(char value)
+{
+  return write((uint8_t)value);
+}
+
+size_t NativeSerial::print(int value)
+{
+  return print((long)value);
+}
+
+size_t NativeSerial::print(unsigned int value)
+{
+  return print((unsigned long)value);
+}
+
+size_t NativeSerial::print(long value)
+{
+  char text[24];
+  snprintf(text, sizeof(text), "%ld", value);
+  return print(text);
+}
+
+size_t NativeSerial::print(unsigned long value)
+{
+  char text[24];
+  snprintf(text, sizeof(text), "%lu", value);
+  return print(text);
+}
+
+size_t NativeSerial::print(double value, int digits)
+{
+  char text[32];
+  snprintf(text, sizeof(text), "%.*f", digits, value);
+  return print(text);
+}
+
+size_t NativeSerial::println(void)
+{
+  return print("\r\n");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// RF24 Shim
+RF24::RF24(uint16_t ce_pin, uint16_t csn_pin)
+    : pa_level(RF24_PA_MAX), payload_size(32), channel(76), data_rate(RF24_1MBPS)
+{
+  (void)ce_pin;
+  (void)csn_pin;
+}
+
+bool RF24::begin(void)
+{
+  radio_channel = channel;
+  radio_data_rate = data_rate;
+  radio_pa_level = pa_level;
+  radio_powered = radio_begin_ok;
+  return radio_begin_ok;
+}
+
+bool RF24::isChipConnected(void) { return radio_begin_ok; }
+void RF24::setPALevel(uint8_t level, bool lna_enable)
+{
+  (void)lna_enable;
+  pa_level = level;
+  radio_pa_level = level;
+}
+uint8_t RF24::getPALevel(void) { return pa_level; }
+bool RF24::setDataRate(rf24_datarate_e speed)
+{
+  data_rate = speed;
+  radio_data_rate = speed;
+  return true;
+}
+rf24_datarate_e RF24::getDataRate(void) { return data_rate; }
+void RF24::setChannel(uint8_t value)
+{
+  channel = (value > 125) ? 125 : value;
+  radio_channel = channel;
+}
+uint8_t RF24::getChannel(void) { return channel; }
+void RF24::setPayloadSize(uint8_t size) { payload_size = (size > RADIO_PAYLOAD_MAX) ? RADIO_PAYLOAD_MAX : size; }
+uint8_t RF24::getPayloadSize(void) { return payload_size; }
+void RF24::openWritingPipe(const uint8_t *address) { (void)address; }
+void RF24::openReadingPipe(uint8_t number, const uint8_t *address)
+{
+  (void)number;
+  (void)address;
+}
+void RF24::startListening(void) {}
+void RF24::stopListening(void) {}
+
+bool RF24::available(void)
+{
+  return radio_count > 0;
+}
+
+bool RF24::available(uint8_t *pipe_num)
+{
+  if (radio_count == 0)
+  {
+    return false;
+  }
+  if (pipe_num != NULL)
+  {
+    *pipe_num = 1;
+  }
+  return true;
+}
+
+void RF24::read(void *buf, uint8_t len)
+{
+  if (radio_count == 0)
+  {
+    return;
+  }
+  uint8_t copy = (len < radio_lengths[radio_head]) ? len : radio_lengths[radio_head];
+  memcpy(buf, radio_queue[radio_head], copy);
+  if (len > copy)
+  {
+    memset((uint8_t *)buf + copy, 0, len - copy);
+  }
+  radio_head = (radio_head + 1) % RADIO_QUEUE_SIZE;
+  radio_count--;
+
+  // The Acknowledgement of This Packet Carried the Oldest Queued Payload
+  if (radio_ack_count > 0)
+  {
+    radio_ack_count--;
+  }
+}
+
+void RF24::enableDynamicPayloads(void) {}
+void RF24::enableAckPayload(void) {}
+
+uint8_t RF24::getDynamicPayloadSize(void)
+{
+  return (radio_count > 0) ? radio_lengths[radio_head] : 0;
+}
+
+bool RF24::writeAckPayload(uint8_t pipe, const void *buf, uint8_t len)
+{
+  (void)pipe;
+  if (radio_ack_count >= RADIO_ACK_FIFO_SIZE)
+  {
+    return false;
+  }
+  radio_ack_length = (len > RADIO_PAYLOAD_MAX) ? RADIO_PAYLOAD_MAX : len;
+  memcpy(radio_ack, buf, radio_ack_length);
+  radio_ack_count++;
+  return true;
+}
+
+uint8_t RF24::flush_tx(void)
+{
+  radio_ack_count = 0;
+  return 0;
+}
+
+uint8_t RF24::flush_rx(void)
+{
+  radio_head = 0;
+  radio_count = 0;
+  return 0;
+}
+
+bool RF24::testRPD(void)
+{
+  return radio_channel < RADIO_CHANNELS && radio_noise[radio_channel];
+}
+
+void RF24::powerDown(void) { radio_powered = false; }
+void RF24::powerUp(void) { radio_powered = true; }
+
+void RF24::maskIRQ(bool tx_ok, bool tx_fail, bool rx_ready)
+{
+  (void)tx_ok;
+  (void)tx_fail;
+  (void)rx_ready;
+}
+
+void RF24::whatHappened(bool &tx_ok, bool &tx_fail, bool &rx_ready)
+{
+  tx_ok = false;
+  tx_fail = false;
+  rx_ready = radio_count > 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// NeoPixel Shim
+static strip_record *find_strip(const Adafruit_NeoPixel *strip)
+{
+  for (uint8_t i = 0; i < NUMBER_STRIPS; i++)
+  {
+    if (strips[i].strip == strip)
+    {
+      return &strips[i];
+    }
+  }
+  return NULL;
+}
+
+Adafruit_NeoPixel::Adafruit_NeoPixel(uint16_t n, int16_t p, uint16_t type)
+    : num_leds(n), pin(p), pixels(new uint32_t[n]()), show_count(0)
+{
+  (void)type;
+  strip_record *record = find_strip(NULL);
+  if (record != NULL)
+  {
+    record->strip = this;
+    record->pin = p;
+  }
+}
+
+Adafruit_NeoPixel::~Adafruit_NeoPixel(void)
+{
+  strip_record *record = find_strip(this);
+  if (record != NULL)
+  {
+    record->strip = NULL;
+  }
+  delete[] pixels;
+}
+
+void Adafruit_NeoPixel::begin(void) {}
+
+void Adafruit_NeoPixel::show(void)
+{
+  strip_record *record = find_strip(this);
+  if (record != NULL)
+  {
+    for (uint16_t i = 0; i < num_leds && i < STRIP_LEDS_MAX; i++)
+    {
+      record->shown[i] = pixels[i];
+    }
+  }
+  show_count++;
+}
+
+void Adafruit_NeoPixel::clear(void)
+{
+  memset(pixels, 0, num_leds * sizeof(uint32_t));
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint32_t c)
+{
+  if (n < num_leds)
+  {
+    pixels[n] = c & 0xFFFFFF;
+  }
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b)
+{
+  setPixelColor(n, Color(r, g, b));
+}
+
+void Adafruit_NeoPixel::setBrightness(uint8_t b) { (void)b; }
+
+uint32_t Adafruit_NeoPixel::getPixelColor(uint16_t n) const
+{
+  return (n < num_leds) ? pixels[n] : 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// EEPROM Shim
+EEPROMClass::EEPROMClass(void)
+{
+  native_eeprom_erase();
+}
+
+uint8_t EEPROMClass::read(int index)
+{
+  return (index >= 0 && index < EEPROM_SIZE) ? eeprom[index] : 0xFF;
+}
+
+void EEPROMClass::write(int index, uint8_t value)
+{
+  if (index >= 0 && index < EEPROM_SIZE)
+  {
+    eeprom[index] = value;
+    eeprom_writes++;
+  }
+}
+
+void EEPROMClass::update(int index, uint8_t value)
+{
+  if (read(index) != value)
+  {
+    write(index, value);
+  }
+}
+
+uint16_t EEPROMClass::length(void)
+{
+  return EEPROM_SIZE;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Harness Functions
+void native_reset(void)
+{
+  time_us = 0;
+  memset(pin_modes, 0, sizeof(pin_modes));
+  memset(pin_levels, 0, sizeof(pin_levels));
+  memset(pin_pwms, 0, sizeof(pin_pwms));
+  memset(analog_values, 0, sizeof(analog_values));
+  memset(interrupt_handlers, 0, sizeof(interrupt_handlers));
+  pin_writes = 0;
+  radio_head = 0;
+  radio_count = 0;
+  radio_begin_ok = true;
+  radio_powered = false;
+  radio_ack_length = 0;
+  radio_ack_count = 0;
+  memset(radio_noise, 0, sizeof(radio_noise));
+}
+
+void native_advance_micros(uint32_t us)
+{
+  time_us += us;
+}
+
+uint64_t native_time_micros(void)
+{
+  return time_us;
+}
+
+void native_set_analog(uint8_t pin, uint16_t value)
+{
+  if (pin < NUM_DIGITAL_PINS)
+  {
+    analog_values[pin] = value;
+  }
+}
+
+uint8_t native_pin_mode(uint8_t pin)
+{
+  return (pin < NUM_DIGITAL_PINS) ? pin_modes[pin] : INPUT;
+}
+
+uint8_t native_pin_level(uint8_t pin)
+{
+  return (pin < NUM_DIGITAL_PINS) ? pin_levels[pin] : LOW;
+}
+
+int native_pin_pwm(uint8_t pin)
+{
+  return (pin < NUM_DIGITAL_PINS) ? pin_pwms[pin] : 0;
+}
+
+uint32_t native_pin_writes(void)
+{
+  return pin_writes;
+}
+
+void native_radio_begin_result(bool ok)
+{
+  radio_begin_ok = ok;
+}
+
+bool native_radio_inject(const void *payload, uint8_t len)
+{
+  // A Powered Down Radio Receives Nothing
+  if (!radio_powered || radio_count >= RADIO_QUEUE_SIZE || len > RADIO_PAYLOAD_MAX)
+  {
+    return false;
+  }
+  uint8_t tail = (radio_head + radio_count) % RADIO_QUEUE_SIZE;
+  memcpy(radio_queue[tail], payload, len);
+  radio_lengths[tail] = len;
+  radio_count++;
+  return true;
+}
+
+bool native_radio_inject_on(uint8_t channel, const void *payload, uint8_t len)
+{
+  // Packets Sent on Another Channel Never Reach the Radio
+  return channel == radio_channel && native_radio_inject(payload, len);
+}
+
+void native_radio_set_noise(uint8_t channel, bool busy)
+{
+  if (channel < RADIO_CHANNELS)
+  {
+    radio_noise[channel] = busy;
+  }
+}
+
+bool native_radio_powered(void)
+{
+  return radio_powered;
+}
+
+uint8_t native_radio_pending(void)
+{
+  return radio_count;
+}
+
+uint8_t native_radio_channel(void)
+{
+  return radio_channel;
+}
+
+uint8_t native_radio_data_rate(void)
+{
+  return radio_data_rate;
+}
+
+uint8_t native_radio_pa_level(void)
+{
+  return radio_pa_level;
+}
+
+uint8_t native_radio_ack_payload(void *payload)
+{
+  memcpy(payload, radio_ack, radio_ack_length);
+  return radio_ack_length;
+}
+
+void native_trigger_interrupt(uint8_t interrupt_number)
+{
+  if (interrupt_number < NUMBER_INTERRUPTS && interrupt_handlers[interrupt_number] != NULL)
+  {
+    interrupt_handlers[interrupt_number]();
+  }
+}
+
+uint32_t native_led_color(uint8_t pin, uint16_t index)
+{
+  for (uint8_t i = 0; i < NUMBER_STRIPS; i++)
+  {
+    if (strips[i].strip != NULL && strips[i].pin == pin && index < STRIP_LEDS_MAX)
+    {
+      return strips[i].shown[index];
+    }
+  }
+  return 0;
+}
+
+uint32_t native_led_shows(uint8_t pin)
+{
+  for (uint8_t i = 0; i < NUMBER_STRIPS; i++)
+  {
+    if (strips[i].strip != NULL && strips[i].pin == pin)
+    {
+      return strips[i].strip->showCount();
+    }
+  }
+  return 0;
+}
+
+void native_serial_sink(FILE *sink)
+{
+  serial_sink = sink;
+}
+
+void native_eeprom_erase(void)
+{
+  memset(eeprom, 0xFF, sizeof(eeprom));
+  eeprom_writes = 0;
+}
+
+uint32_t native_eeprom_writes(void)
+{
+  return eeprom_writes;
+}
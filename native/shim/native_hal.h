@@ -0,0 +1,54 @@
+// Harness Side of the Host (Native) Arduino Shim
+#pragma once
+
+/***********************************************************************************************************************
+ *
+ *  Functions used by host programs (benchmarks, replay, simulation) to drive the simulated hardware the firmware runs
+ *  against: advance the clock, set analog inputs, inject radio packets and observe pin, PWM and LED state.
+ *
+ **********************************************************************************************************************/
+
+#include <Arduino.h>
+#include <stdio.h>
+
+// Resets Clock, Pins, Radio Queue and Counters to Power-On State
+void native_reset(void);
+
+// Simulated Clock Control
+void native_advance_micros(uint32_t us);
+uint64_t native_time_micros(void);
+
+// Simulated Analog Inputs (Raw 10-bit ADC Counts)
+void native_set_analog(uint8_t pin, uint16_t value);
+
+// Simulated Pin Observation
+uint8_t native_pin_mode(uint8_t pin);
+uint8_t native_pin_level(uint8_t pin);
+int native_pin_pwm(uint8_t pin);
+uint32_t native_pin_writes(void);
+
+// Simulated Radio Control
+void native_radio_begin_result(bool ok);
+bool native_radio_inject(const void *payload, uint8_t len);
+bool native_radio_inject_on(uint8_t channel, const void *payload, uint8_t len);
+void native_radio_set_noise(uint8_t channel, bool busy);
+bool native_radio_powered(void);
+uint8_t native_radio_pending(void);
+uint8_t native_radio_channel(void);
+uint8_t native_radio_data_rate(void);
+uint8_t native_radio_pa_level(void);
+uint8_t native_radio_ack_payload(void *payload);
+
+// Simulated External Interrupts
+void native_trigger_interrupt(uint8_t interrupt_number);
+
+// Simulated LEDs Observation (Last Shown Frame of the Strip on the Given Pin)
+uint32_t native_led_color(uint8_t pin, uint16_t index);
+uint32_t native_led_shows(uint8_t pin);
+
+// Simulated EEPROM (Kept Across native_reset(), Like the Real One)
+void native_eeprom_erase(void);
+uint32_t native_eeprom_writes(void);
+
+// Serial Port Output Sink (NULL Discards Output)
+void native_serial_sink(FILE *sink);
@@ -0,0 +1,6 @@
+// RF24 printf Helper Shim for Host (Native) Builds
+#pragma once
+
+#include <stdio.h>
+
+inline void printf_begin(void) {}
@@ -0,0 +1,471 @@
+// Host (Native) Mecanum Trajectory Simulation
+#include <Arduino.h>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "native_hal.h"
+#include "controller.h"
+#include "radio_frame.h"
+#include "motor_driver.h"
+#include "encoders.h"
+#include "speed_control.h"
+#include "ramp.h"
+#include "buttons.h"
+#include "battery.h"
+#include "robot_state.h"
+#include "motor_plant.h"
+
+/***********************************************************************************************************************
+ *
+ *  Drives the unmodified setup()/loop() of src/main.cpp with scripted stick inputs and moves the motor and chassis
+ *  model of motor_plant.h with the wheel duties and directions the firmware writes, to see how the robot actually
+ *  travels. Alongside, a reference robot follows the motion the firmware was asked for (the stick deflections, control
+ *  mode and speed_max it holds) with ideal wheels that reach their speed at once and never slip, so the distance
+ *  between both poses is the tracking error of everything in between: mixer, ramps, speed control, voltage
+ *  compensation and the motors themselves.
+ *
+ *  Scripts are CSV files of segments, each holding a set of controller readings for a time:
+ *
+ *    # omnirobot drive script v1
+ *    duration_ms,buttons,X1,Y1,X2,Y2,slider1,slider2
+ *
+ *  buttons is a mask in buttons_state() order (bit 0 is button 1); bit 0 is set by the control mode of each run, so it
+ *  should be left clear. Every script runs in every requested mode and ramp profile, one after the other from rest at
+ *  the origin, and each run prints one summary row. Given a CSV output, a row is written every sample period with the
+ *  pose, the reference pose, the wheel speeds and the tracking error of each run.
+ *
+ *  Usage: program <script.csv>... [--mode 1|2|both] [--ramp firmware|gentle|normal|sport|none|all]
+ *                 [--battery <volts>] [--csv <out.csv>] [--sample-ms <period>]
+ *
+ **********************************************************************************************************************/
+
+// Firmware Entry Points and State
+void setup();
+void loop();
+extern robot_state robot;
+
+// Simulation Parameters
+const uint8_t PIN_BAT = A3;
+const uint32_t STEP_US = 100;
+const uint32_t PACKET_PERIOD_US = 20000;
+const uint32_t SETTLE_US = 15000000;
+const uint32_t REST_US = 1000000;
+
+// Control Tick of src/main.cpp (1000000 / CONTROL_RATE)
+const uint32_t CONTROL_TICK_US = 2000;
+
+// Script Header and Columns
+const char SCRIPT_MAGIC[] = "# omnirobot drive script v1";
+const char SCRIPT_COLUMNS[] = "duration_ms,";
+
+// Sticks and Sliders at Rest
+const uint16_t CENTER = 512;
+
+// Button Setting the Control Mode (Held for Mode 2)
+const uint8_t MODE_BUTTON = 0x01;
+
+// Wheel Pins and Encoder Interrupts in Drive Command Order
+typedef struct
+{
+  uint8_t dir;
+  uint8_t en;
+  uint8_t encoder;
+} wheel_pins;
+const wheel_pins WHEELS[NUMBER_WHEELS] = {
+    {PIN_DIRB, PIN_ENB, ENCODER_PIN_FRONT_LEFT},
+    {PIN_DIRD, PIN_END, ENCODER_PIN_FRONT_RIGHT},
+    {PIN_DIRA, PIN_ENA, ENCODER_PIN_BACK_LEFT},
+    {PIN_DIRC, PIN_ENC, ENCODER_PIN_BACK_RIGHT},
+};
+
+// Ramp Profiles to Sweep (No Profile Keeps the One Set by setup())
+typedef struct
+{
+  const char *name;
+  const ramp_profile *profile;
+} ramp_choice;
+const ramp_choice RAMPS[] = {
+    {"firmware", NULL},
+    {"gentle", &RAMP_GENTLE},
+    {"normal", &RAMP_NORMAL},
+    {"sport", &RAMP_SPORT},
+    {"none", &RAMP_NONE},
+};
+const uint8_t NUMBER_RAMPS = sizeof(RAMPS) / sizeof(RAMPS[0]);
+
+// Script Segment
+typedef struct
+{
+  uint32_t duration_us;
+  controller_variables controller;
+} script_segment;
+
+// Drive Script
+typedef struct
+{
+  std::string name;
+  std::vector<script_segment> segments;
+} drive_script;
+
+// Outcome of One Run (Errors in Meters)
+typedef struct
+{
+  robot_plant robot;
+  float final_error;
+  float rms_error;
+  float max_error;
+} run_result;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Set the Buttons Readings from a Mask
+static void unpack_buttons(uint8_t buttons, controller_variables &controller)
+{
+  controller.button1_reading = (buttons & 0x01) ? 1 : 0;
+  controller.button2_reading = (buttons & 0x02) ? 1 : 0;
+  controller.button3_reading = (buttons & 0x04) ? 1 : 0;
+  controller.button4_reading = (buttons & 0x08) ? 1 : 0;
+  controller.button5_reading = (buttons & 0x10) ? 1 : 0;
+  controller.button6_reading = (buttons & 0x20) ? 1 : 0;
+}
+
+// Function to Load a Script, False on Any Malformed Line
+static bool load_script(const char *path, drive_script &script)
+{
+  FILE *file = fopen(path, "r");
+  if (file == NULL)
+  {
+    fprintf(stderr, "cannot open %s\n", path);
+    return false;
+  }
+
+  // Runs Are Named After the File Without its Directory and Extension
+  script.name = path;
+  script.name = script.name.substr(script.name.find_last_of('/') + 1);
+  script.name = script.name.substr(0, script.name.find_last_of('.'));
+
+  char line[256];
+  uint32_t number = 0;
+  while (fgets(line, sizeof(line), file) != NULL)
+  {
+    number++;
+    if (number == 1 && strncmp(line, SCRIPT_MAGIC, strlen(SCRIPT_MAGIC)) != 0)
+    {
+      fprintf(stderr, "%s: not a drive script (first line is not \"%s\")\n", path, SCRIPT_MAGIC);
+      fclose(file);
+      return false;
+    }
+    if (line[0] == '#' || line[0] == '\n' || strncmp(line, SCRIPT_COLUMNS, strlen(SCRIPT_COLUMNS)) == 0)
+    {
+      continue;
+    }
+
+    unsigned long duration_ms;
+    unsigned int fields[7];
+    int parsed = sscanf(line, "%lu,%u,%u,%u,%u,%u,%u,%u", &duration_ms, &fields[0], &fields[1], &fields[2], &fields[3],
+                        &fields[4], &fields[5], &fields[6]);
+    if (parsed != 8)
+    {
+      fprintf(stderr, "%s:%u: expected 8 fields\n", path, number);
+      fclose(file);
+      return false;
+    }
+
+    script_segment segment;
+    segment.duration_us = duration_ms * 1000;
+    unpack_buttons(fields[0], segment.controller);
+    segment.controller.X1axis_reading = fields[1];
+    segment.controller.Y1axis_reading = fields[2];
+    segment.controller.X2axis_reading = fields[3];
+    segment.controller.Y2axis_reading = fields[4];
+    segment.controller.slider1_reading = fields[5];
+    segment.controller.slider2_reading = fields[6];
+    script.segments.push_back(segment);
+  }
+  fclose(file);
+
+  if (script.segments.empty())
+  {
+    fprintf(stderr, "%s: no segments to run\n", path);
+    return false;
+  }
+  return true;
+}
+
+// Function to Send a Packet to the Firmware
+static void send_packet(const controller_variables &controller)
+{
+  static uint8_t sequence = 0;
+  radio_frame frame;
+  radio_frame_encode(controller, sequence++, frame);
+  native_radio_inject(&frame, sizeof(frame));
+#ifdef RADIO_IRQ_PIN
+  native_trigger_interrupt(digitalPinToInterrupt(RADIO_IRQ_PIN));
+#endif
+}
+
+// Function to Hold the Sticks at Rest for a While, Sliders as Given
+static void rest(uint32_t duration_us, uint8_t buttons, const controller_variables &sliders)
+{
+  controller_variables controller;
+  memset(&controller, 0, sizeof(controller));
+  unpack_buttons(buttons, controller);
+  controller.X1axis_reading = CENTER;
+  controller.Y1axis_reading = CENTER;
+  controller.X2axis_reading = CENTER;
+  controller.Y2axis_reading = CENTER;
+  controller.slider1_reading = sliders.slider1_reading;
+  controller.slider2_reading = sliders.slider2_reading;
+  for (uint32_t t = 0; t < duration_us; t += STEP_US)
+  {
+    if (t % PACKET_PERIOD_US == 0)
+    {
+      send_packet(controller);
+    }
+    native_advance_micros(STEP_US);
+    loop();
+  }
+}
+
+// Function to Set the Reference Wheel Speeds from the Motion the Firmware Was Asked For (Mixer Equations Unquantized)
+static void reference_speeds(robot_plant &reference)
+{
+  const float forward = (float)robot.forward / DEFLECTION_FULL_SCALE;
+  const float x1 = (float)robot.lateral1 / DEFLECTION_FULL_SCALE;
+  const float x2 = (float)robot.lateral2 / DEFLECTION_FULL_SCALE;
+  const float strafe = robot.mode ? x2 : x1;
+  const float turn = robot.mode ? x1 : x2;
+
+  float wheel[NUMBER_WHEELS];
+  wheel[WHEEL_FRONT_LEFT] = forward - strafe - turn;
+  wheel[WHEEL_FRONT_RIGHT] = forward + strafe + turn;
+  wheel[WHEEL_BACK_LEFT] = forward + strafe - turn;
+  wheel[WHEEL_BACK_RIGHT] = forward - strafe + turn;
+
+  // Full Deflection Turns a Wheel at the speed_max Share of Full Scale
+  float peak = 1;
+  for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+  {
+    peak = fmaxf(peak, fabsf(wheel[i]));
+  }
+  const float full = robot.speed_max / 255.0f * SPEED_FULL_SCALE_HZ / MOTOR_DEFAULT.edges_per_rad;
+  for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+  {
+    reference.wheels[i].speed = wheel[i] / peak * full;
+  }
+}
+
+// Function to Run One Script in One Mode and Ramp Profile, Writing Samples to csv (If Any)
+static run_result run(const drive_script &script, bool mode, const ramp_choice &ramp, float battery, FILE *csv,
+                      uint32_t sample_us)
+{
+  // Firmware Comes to Rest in the Mode of the Run Before the Robot is Placed at the Origin
+  const uint8_t mode_buttons = mode ? 0 : MODE_BUTTON;
+  rest(REST_US, mode_buttons, script.segments[0].controller);
+  if (ramp.profile != NULL)
+  {
+    for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+    {
+      ramp_configure(i, *ramp.profile, CONTROL_TICK_US);
+    }
+  }
+
+  run_result result;
+  robot_plant reference;
+  plant_begin(result.robot, MOTOR_DEFAULT);
+  plant_begin(reference, MOTOR_DEFAULT);
+  double squared = 0;
+  uint32_t samples = 0;
+  result.max_error = 0;
+
+  uint32_t t = 0;
+  for (size_t s = 0; s < script.segments.size(); s++)
+  {
+    controller_variables controller = script.segments[s].controller;
+    unpack_buttons((buttons_pack(controller) & ~MODE_BUTTON) | mode_buttons, controller);
+    const uint32_t end = t + script.segments[s].duration_us;
+    for (; t < end; t += STEP_US)
+    {
+      if (t % PACKET_PERIOD_US == 0)
+      {
+        send_packet(controller);
+      }
+      native_advance_micros(STEP_US);
+      loop();
+
+      // Direction Pin Low Drives the Wheel Forward
+      for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+      {
+        float duty = native_pin_pwm(WHEELS[i].en) / 255.0f;
+        duty = native_pin_level(WHEELS[i].dir) ? -duty : duty;
+        uint16_t edges = plant_wheel_step(result.robot.wheels[i], duty, battery, STEP_US * 1e-6f);
+        int8_t interrupt = digitalPinToInterrupt(WHEELS[i].encoder);
+        for (uint16_t e = 0; e < edges && interrupt >= 0; e++)
+        {
+          native_trigger_interrupt(interrupt);
+        }
+      }
+      plant_move(result.robot, STEP_US * 1e-6f);
+      reference_speeds(reference);
+      plant_move(reference, STEP_US * 1e-6f);
+
+      // Tracking Error Sampled Every Sample Period
+      if ((t + STEP_US) % sample_us != 0)
+      {
+        continue;
+      }
+      float error = hypotf(result.robot.x - reference.x, result.robot.y - reference.y);
+      squared += (double)error * error;
+      samples++;
+      result.max_error = fmaxf(result.max_error, error);
+      if (csv != NULL)
+      {
+        fprintf(csv, "%s,%u,%s,%.3f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f\n", script.name.c_str(),
+                mode ? 1 : 2, ramp.name, (t + STEP_US) / 1e6, result.robot.x * 100, result.robot.y * 100,
+                result.robot.heading * 180 / M_PI, reference.x * 100, reference.y * 100,
+                reference.heading * 180 / M_PI, error * 100, (result.robot.heading - reference.heading) * 180 / M_PI,
+                result.robot.wheels[0].speed, result.robot.wheels[1].speed, result.robot.wheels[2].speed,
+                result.robot.wheels[3].speed);
+      }
+    }
+  }
+
+  result.final_error = hypotf(result.robot.x - reference.x, result.robot.y - reference.y);
+  result.rms_error = (samples > 0) ? sqrt(squared / samples) : 0;
+  return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+  std::vector<drive_script> scripts;
+  const char *mode_choice = "both";
+  const char *ramp_name = "firmware";
+  const char *csv_path = NULL;
+  float battery = 8.2f;
+  uint32_t sample_ms = 10;
+  bool usage = false;
+  for (int i = 1; i < argc && !usage; i++)
+  {
+    if (strcmp(argv[i], "--mode") == 0 && i + 1 < argc)
+    {
+      mode_choice = argv[++i];
+    }
+    else if (strcmp(argv[i], "--ramp") == 0 && i + 1 < argc)
+    {
+      ramp_name = argv[++i];
+    }
+    else if (strcmp(argv[i], "--battery") == 0 && i + 1 < argc)
+    {
+      battery = atof(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+    {
+      csv_path = argv[++i];
+    }
+    else if (strcmp(argv[i], "--sample-ms") == 0 && i + 1 < argc)
+    {
+      sample_ms = strtoul(argv[++i], NULL, 10);
+    }
+    else if (argv[i][0] != '-')
+    {
+      drive_script script;
+      if (!load_script(argv[i], script))
+      {
+        return 2;
+      }
+      scripts.push_back(script);
+    }
+    else
+    {
+      usage = true;
+    }
+  }
+
+  // Modes and Ramp Profiles to Sweep
+  std::vector<bool> modes;
+  if (strcmp(mode_choice, "1") == 0 || strcmp(mode_choice, "both") == 0)
+  {
+    modes.push_back(true);
+  }
+  if (strcmp(mode_choice, "2") == 0 || strcmp(mode_choice, "both") == 0)
+  {
+    modes.push_back(false);
+  }
+  std::vector<const ramp_choice *> ramps;
+  for (uint8_t i = 0; i < NUMBER_RAMPS; i++)
+  {
+    if (strcmp(ramp_name, RAMPS[i].name) == 0 || (strcmp(ramp_name, "all") == 0 && RAMPS[i].profile != NULL))
+    {
+      ramps.push_back(&RAMPS[i]);
+    }
+  }
+  if (usage || scripts.empty() || modes.empty() || ramps.empty() || sample_ms == 0 || battery <= 0)
+  {
+    fprintf(stderr,
+            "usage: %s <script.csv>... [--mode 1|2|both] [--ramp firmware|gentle|normal|sport|none|all]\n"
+            "       [--battery <volts>] [--csv <out.csv>] [--sample-ms <period>]\n",
+            argv[0]);
+    return 2;
+  }
+
+  FILE *csv = NULL;
+  if (csv_path != NULL)
+  {
+    csv = fopen(csv_path, "w");
+    if (csv == NULL)
+    {
+      fprintf(stderr, "cannot write %s\n", csv_path);
+      return 2;
+    }
+    fprintf(csv, "script,mode,ramp,time_s,x_cm,y_cm,heading_deg,ref_x_cm,ref_y_cm,ref_heading_deg,error_cm,"
+                 "heading_error_deg,front_left_rad_s,front_right_rad_s,back_left_rad_s,back_right_rad_s\n");
+  }
+
+  // Starts the Firmware and Lets the Battery Filters and the Sticks Calibration at Rest Settle
+  native_reset();
+  native_set_analog(PIN_BAT, battery_counts(battery) >> BATTERY_FILTER_SHIFT);
+  setup();
+  rest(SETTLE_US, 0, scripts[0].segments[0].controller);
+
+  printf("Battery %.1f V, pose error against the ideal robot following the same commands\n", battery);
+  printf("%-20s %4s %-8s %8s %8s %8s %9s %10s %10s %10s\n", "script", "mode", "ramp", "time (s)", "x (cm)", "y (cm)",
+         "head (deg)", "final (cm)", "rms (cm)", "max (cm)");
+
+  double simulated = 0;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (size_t s = 0; s < scripts.size(); s++)
+  {
+    uint32_t duration_us = 0;
+    for (size_t i = 0; i < scripts[s].segments.size(); i++)
+    {
+      duration_us += scripts[s].segments[i].duration_us;
+    }
+    for (size_t m = 0; m < modes.size(); m++)
+    {
+      for (size_t r = 0; r < ramps.size(); r++)
+      {
+        run_result result = run(scripts[s], modes[m], *ramps[r], battery, csv, sample_ms * 1000);
+        printf("%-20s %4u %-8s %8.2f %8.1f %8.1f %9.1f %10.1f %10.1f %10.1f\n", scripts[s].name.c_str(),
+               modes[m] ? 1 : 2, ramps[r]->name, duration_us / 1e6, result.robot.x * 100, result.robot.y * 100,
+               result.robot.heading * 180 / M_PI, result.final_error * 100, result.rms_error * 100,
+               result.max_error * 100);
+        simulated += (duration_us + REST_US) / 1e6;
+      }
+    }
+  }
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+  if (csv != NULL)
+  {
+    fclose(csv);
+  }
+  double seconds = std::chrono::duration<double>(end - start).count();
+  printf("%.1f s simulated in %.2f s (%.0fx real time)\n", simulated, seconds, simulated / seconds);
+  return 0;
+}
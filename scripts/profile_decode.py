@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""Decodes the binary profiler frames sent by the robot built with PROFILE defined.
+
+Usage: profile_decode.py <serial device or capture file>
+
+Reads the port (or a file with captured bytes), finds every valid frame and prints one table per
+frame with the count, min, mean, max and histogram of each loop stage in microseconds.
+"""
+
+import struct
+import sys
+
+STAGES = ["battery", "radio", "debounce", "mixing", "motors", "lights"]
+BUCKETS = 8
+STAGE_FORMAT = "<HHHI" + "H" * BUCKETS
+STAGE_SIZE = struct.calcsize(STAGE_FORMAT)
+
+
+def frames(stream):
+    buffer = b""
+    while True:
+        chunk = stream.read(64)
+        if not chunk:
+            return
+        buffer += chunk
+        while True:
+            start = buffer.find(b"\xa5\x5a")
+            if start < 0 or len(buffer) < start + 6:
+                buffer = buffer[max(start, 0):] if start >= 0 else buffer[-1:]
+                break
+            stages = buffer[start + 3]
+            size = 6 + stages * STAGE_SIZE + 1
+            if len(buffer) < start + size:
+                buffer = buffer[start:]
+                break
+            frame = buffer[start:start + size]
+            if sum(frame) & 0xFF == 0:
+                yield frame
+                buffer = buffer[start + size:]
+            else:
+                buffer = buffer[start + 1:]
+
+
+def print_frame(frame):
+    version, stages, tick_ns = struct.unpack_from("<BBH", frame, 2)
+    tick_us = tick_ns / 1000.0
+    print(f"version {version}, tick {tick_ns} ns")
+    print(f"{'stage':<10}{'count':>8}{'min us':>10}{'mean us':>10}{'max us':>10}  histogram (0, <2, <4, ... ticks)")
+    for index in range(stages):
+        fields = struct.unpack_from(STAGE_FORMAT, frame, 6 + index * STAGE_SIZE)
+        count, minimum, maximum, total = fields[:4]
+        histogram = fields[4:]
+        name = STAGES[index] if index < len(STAGES) else f"stage{index}"
+        mean = total / count if count else 0.0
+        print(f"{name:<10}{count:>8}{minimum * tick_us:>10.1f}{mean * tick_us:>10.1f}{maximum * tick_us:>10.1f}  "
+              + " ".join(str(value) for value in histogram))
+    print()
+
+
+def main():
+    if len(sys.argv) != 2:
+        print(__doc__)
+        return 1
+    with open(sys.argv[1], "rb", buffering=0) as stream:
+        for frame in frames(stream):
+            print_frame(frame)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,77 @@
+# Per-Symbol RAM/Flash Size Report
+#
+# Lists every symbol of the firmware ELF with the SRAM and flash it takes, biggest first, followed by the totals and
+# the SRAM left for the stack on the ATmega32u4. Runs after every build of an environment listing it as
+#   extra_scripts = post:scripts/size_report.py
+# printing the report and keeping it as size_report.txt in the build directory. It also runs on its own:
+#   python scripts/size_report.py <firmware.elf> [nm tool]
+
+import subprocess
+import sys
+
+# ATmega32u4 Memories (Bytes)
+SRAM_SIZE = 2560
+FLASH_SIZE = 28672  # 32 KB Less the Caterina Bootloader
+
+# Symbols Shown in Each Table
+SYMBOLS_SHOWN = 40
+
+# nm Types: Zeroed (bss) and Initialized (data) Variables Take SRAM, Data Also Takes Flash for its Initial Value
+RAM_TYPES = "bBdD"
+DATA_TYPES = "dD"
+
+
+# Function to Read the Sized Symbols of an ELF
+def read_symbols(elf, nm):
+    output = subprocess.check_output([nm, "--print-size", "--size-sort", "--demangle", elf], universal_newlines=True)
+    symbols = []
+    for line in output.splitlines():
+        fields = line.split(None, 3)
+        if len(fields) == 4:
+            symbols.append((fields[3], int(fields[1], 16), fields[2]))
+    return symbols
+
+
+# Function to Format the Report
+def format_report(symbols):
+    ram = sorted([s for s in symbols if s[2] in RAM_TYPES], key=lambda s: -s[1])
+    flash = sorted([s for s in symbols if s[2] not in RAM_TYPES or s[2] in DATA_TYPES], key=lambda s: -s[1])
+    ram_total = sum(s[1] for s in ram)
+    flash_total = sum(s[1] for s in flash)
+
+    lines = []
+    for title, table in (("SRAM", ram), ("Flash", flash)):
+        lines.append("%s by symbol (%d symbols, %d shown)" % (title, len(table), min(len(table), SYMBOLS_SHOWN)))
+        for name, size, kind in table[:SYMBOLS_SHOWN]:
+            lines.append("  %6d  %s  %s" % (size, kind, name))
+        lines.append("")
+    lines.append("SRAM:  %6d of %6d bytes in static variables, %d left for the heap and stack"
+                 % (ram_total, SRAM_SIZE, SRAM_SIZE - ram_total))
+    lines.append("Flash: %6d of %6d bytes in sized symbols (vectors and library glue not included)"
+                 % (flash_total, FLASH_SIZE))
+    return "\n".join(lines) + "\n"
+
+
+# Function to Write the Report
+def report(elf, nm, path=None):
+    text = format_report(read_symbols(elf, nm))
+    sys.stdout.write(text)
+    if path is not None:
+        with open(path, "w") as report_file:
+            report_file.write(text)
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        sys.stderr.write("usage: %s <firmware.elf> [nm tool]\n" % sys.argv[0])
+        sys.exit(2)
+    report(sys.argv[1], sys.argv[2] if len(sys.argv) > 2 else "avr-nm")
+else:
+    # PlatformIO Post Build Action
+    Import("env")  # noqa: F821
+
+    def size_report_action(source, target, env):
+        nm = env.subst("$CC").replace("gcc", "nm")
+        report(str(source[0]), nm, env.subst("$BUILD_DIR/size_report.txt"))
+
+    env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", size_report_action)  # noqa: F821
@@ -0,0 +1,74 @@
+// Battery Voltage Monitor
+#include <Arduino.h>
+#include "battery.h"
+
+#if defined(__AVR_ATmega32U4__)
+#include <util/atomic.h>
+#endif
+
+// Filtered Reading
+static volatile uint16_t filtered = 0;
+static uint8_t battery_pin;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+#if defined(__AVR_ATmega32U4__)
+
+// ADC Conversion Complete Interrupt
+ISR(ADC_vect)
+{
+  filtered = filtered - (filtered >> BATTERY_FILTER_SHIFT) + ADC;
+}
+
+// Function to Start the Battery Monitor
+void battery_begin(uint8_t pin)
+{
+  battery_pin = pin;
+
+  // Blocking Reading Seeds the Filter and Leaves the Multiplexer on the Battery Pin
+  filtered = (uint16_t)analogRead(pin) << BATTERY_FILTER_SHIFT;
+
+  // Auto Triggers Conversions on Timer0 Overflow, Keeping the MUX5 Bit Set by analogRead()
+  ADCSRB = (ADCSRB & (1 << MUX5)) | (1 << ADTS2);
+  ADCSRA |= (1 << ADIF) | (1 << ADATE) | (1 << ADIE);
+}
+
+// Function to Sample the Battery (Done by the ADC Interrupt)
+void battery_sample(void)
+{
+}
+
+// Function to Read the Filtered Battery Voltage
+uint16_t battery_reading(void)
+{
+  uint16_t reading;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+  {
+    reading = filtered;
+  }
+  return reading;
+}
+
+#else
+
+// Function to Start the Battery Monitor
+void battery_begin(uint8_t pin)
+{
+  battery_pin = pin;
+  filtered = (uint16_t)analogRead(pin) << BATTERY_FILTER_SHIFT;
+}
+
+// Function to Sample the Battery
+void battery_sample(void)
+{
+  filtered = filtered - (filtered >> BATTERY_FILTER_SHIFT) + analogRead(battery_pin);
+}
+
+// Function to Read the Filtered Battery Voltage
+uint16_t battery_reading(void)
+{
+  return filtered;
+}
+
+#endif
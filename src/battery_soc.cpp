@@ -0,0 +1,207 @@
+// Battery State of Charge Estimator
+#include <Arduino.h>
+#include "battery_soc.h"
+
+// Resting Voltage of One LiPo Cell Every CELL_CURVE_STEP Percent of Charge (Millivolts, Empty First)
+static constexpr uint16_t CELL_CURVE_MV[] = {3270, 3610, 3690, 3710, 3730, 3750, 3770, 3790, 3800, 3820, 3840,
+                                             3850, 3870, 3910, 3950, 3980, 4020, 4080, 4110, 4150, 4200};
+static const uint8_t CELL_CURVE_POINTS = sizeof(CELL_CURVE_MV) / sizeof(CELL_CURVE_MV[0]);
+static const uint8_t CELL_CURVE_STEP = 5;
+
+// Charge Fraction and Model State Scaling
+static const uint8_t CHARGE_SHIFT = 8;
+static const uint16_t TABLE_STEP_MASK = (1 << SOC_TABLE_STEP_SHIFT) - 1;
+
+// Sum of the Four Q15 Duties Down to the Load
+static const uint8_t LOAD_SHIFT = 15 + 2 - SOC_LOAD_FULL_SHIFT;
+static_assert(NUMBER_WHEELS == 4 && DUTY_FULL_SCALE == 32767, "the load shift stands for four Q15 duties");
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Table Builders (Evaluated at Compile Time)
+constexpr float cell_charge(float cell_mv, uint8_t point)
+{
+  return (cell_mv <= CELL_CURVE_MV[0])        ? 0
+         : (point >= CELL_CURVE_POINTS - 1)   ? 100
+         : (cell_mv < CELL_CURVE_MV[point + 1])
+             ? CELL_CURVE_STEP * (point + (cell_mv - CELL_CURVE_MV[point]) /
+                                              (CELL_CURVE_MV[point + 1] - CELL_CURVE_MV[point]))
+             : cell_charge(cell_mv, point + 1);
+}
+
+constexpr uint8_t entry_charge(uint8_t index)
+{
+  return (uint8_t)(cell_charge((SOC_TABLE_MV + ((uint16_t)index << SOC_TABLE_STEP_SHIFT)) / (float)SOC_CELLS, 0) +
+                   0.5);
+}
+
+// Charge (Percent) of Each Table Entry
+#define SOC_ENTRIES_4(i) entry_charge(i), entry_charge(i + 1), entry_charge(i + 2), entry_charge(i + 3)
+#define SOC_ENTRIES_16(i) SOC_ENTRIES_4(i), SOC_ENTRIES_4(i + 4), SOC_ENTRIES_4(i + 8), SOC_ENTRIES_4(i + 12)
+static const uint8_t CHARGES[SOC_TABLE_SIZE] PROGMEM = {SOC_ENTRIES_16(0), SOC_ENTRIES_16(16)};
+static_assert(entry_charge(SOC_TABLE_SIZE - 1) == 100, "the charge table must reach a full pack");
+
+// Model State (Millivolts Scaled by 2^SOC_GAIN_SHIFT)
+static int32_t open_circuit = 0;
+static int32_t resistance = 0;
+
+// Load Filter (Scaled by 2^SOC_LOAD_FILTER_SHIFT)
+static uint16_t load_filtered = 0;
+
+// Drain Measurement
+static uint16_t cutoff_mv = 0;
+static uint16_t reserve = 0;
+static unsigned long last_update = 0;
+static uint16_t window_ms = 0;
+static uint16_t window_charge = 0;
+static uint8_t window_peak = 0;
+static uint16_t drain = 0;
+
+// Estimate
+static soc_stats stats;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Look Up the Charge of an Open Circuit Voltage (1/256 Percent)
+static uint16_t lookup(uint16_t millivolts)
+{
+  if (millivolts <= SOC_TABLE_MV)
+  {
+    return pgm_read_byte(&CHARGES[0]) << CHARGE_SHIFT;
+  }
+  uint16_t offset = millivolts - SOC_TABLE_MV;
+  uint16_t index = offset >> SOC_TABLE_STEP_SHIFT;
+  if (index >= SOC_TABLE_SIZE - 1)
+  {
+    return pgm_read_byte(&CHARGES[SOC_TABLE_SIZE - 1]) << CHARGE_SHIFT;
+  }
+
+  // Interpolates Between the Two Entries Around the Voltage (Charges Rise With the Voltage)
+  uint8_t low = pgm_read_byte(&CHARGES[index]);
+  uint8_t high = pgm_read_byte(&CHARGES[index + 1]);
+  uint16_t fraction = offset & TABLE_STEP_MASK;
+  return ((uint16_t)low << CHARGE_SHIFT) +
+         (uint16_t)(((uint32_t)(high - low) * fraction << CHARGE_SHIFT) >> SOC_TABLE_STEP_SHIFT);
+}
+
+// Function to Work Out the Minutes Left From the Drain per Minute
+static void update_minutes(void)
+{
+  if (drain == 0)
+  {
+    stats.minutes = SOC_MINUTES_UNKNOWN;
+    return;
+  }
+  uint16_t left = (stats.charge > reserve) ? stats.charge - reserve : 0;
+  uint16_t minutes = left / drain;
+  stats.minutes = (minutes < SOC_MINUTES_UNKNOWN) ? minutes : SOC_MINUTES_UNKNOWN - 1;
+}
+
+// Function to Close a Window of Driving
+static void close_window(void)
+{
+  // Charge Used per Minute of Driving, Smoothed Across Windows (A Recovery After a Hard Run Counts as None)
+  uint16_t used = (window_charge > stats.charge) ? window_charge - stats.charge : 0;
+  uint16_t used_per_minute = (uint32_t)used * 60000UL / SOC_WINDOW_MS;
+  if (drain == 0)
+  {
+    drain = used_per_minute;
+  }
+  else
+  {
+    drain = (int32_t)drain + (((int32_t)used_per_minute - (int32_t)drain) >> 2);
+  }
+
+  // Charge Left When the Failsafe Trips, at the First Sag Below the Cutoff Under the Peak Load of the Window
+  reserve = lookup(cutoff_mv + (uint16_t)(((uint32_t)stats.resistance_mv * window_peak) >> SOC_LOAD_FULL_SHIFT));
+
+  window_ms = 0;
+  window_peak = 0;
+  window_charge = stats.charge;
+}
+
+// Function to Start the Estimator
+void soc_begin(uint16_t reading, uint16_t cutoff_reading)
+{
+  uint16_t millivolts = battery_millivolts(reading);
+  open_circuit = (int32_t)millivolts << SOC_GAIN_SHIFT;
+  resistance = (int32_t)SOC_RESISTANCE_START_MV << SOC_GAIN_SHIFT;
+  load_filtered = 0;
+
+  stats.open_circuit_mv = millivolts;
+  stats.resistance_mv = SOC_RESISTANCE_START_MV;
+  stats.load = 0;
+  stats.charge = lookup(millivolts);
+  stats.percent = (stats.charge + (1 << (CHARGE_SHIFT - 1))) >> CHARGE_SHIFT;
+  stats.minutes = SOC_MINUTES_UNKNOWN;
+
+  cutoff_mv = battery_millivolts(cutoff_reading);
+  reserve = lookup(cutoff_mv);
+  last_update = millis();
+  window_ms = 0;
+  window_charge = stats.charge;
+  window_peak = 0;
+  drain = 0;
+}
+
+// Function to Feed the Wheel Duties
+void soc_load(const drive_command &drive)
+{
+  uint32_t total = 0;
+  for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+  {
+    int16_t duty = drive.duty[i];
+    total += (duty < 0) ? -duty : duty;
+  }
+  uint8_t load = total >> LOAD_SHIFT;
+  load_filtered = load_filtered - (load_filtered >> SOC_LOAD_FILTER_SHIFT) + load;
+}
+
+// Function to Feed a Battery Reading
+void soc_update(uint16_t reading, unsigned long now)
+{
+  uint16_t millivolts = battery_millivolts(reading);
+  uint8_t load = load_filtered >> SOC_LOAD_FILTER_SHIFT;
+
+  // Least Mean Squares Step: the Error Goes to the Open Circuit Voltage at Rest, to the Resistance Under Load
+  int32_t sag = ((resistance >> SOC_GAIN_SHIFT) * load) >> SOC_LOAD_FULL_SHIFT;
+  int32_t error = (int32_t)millivolts - ((open_circuit >> SOC_GAIN_SHIFT) - sag);
+  open_circuit += (error * ((1 << SOC_LOAD_FULL_SHIFT) - load)) >> SOC_LOAD_FULL_SHIFT;
+  resistance -= (error * load) >> SOC_LOAD_FULL_SHIFT;
+  if (resistance < 0)
+  {
+    resistance = 0;
+  }
+  else if (resistance > ((int32_t)SOC_RESISTANCE_MAX_MV << SOC_GAIN_SHIFT))
+  {
+    resistance = (int32_t)SOC_RESISTANCE_MAX_MV << SOC_GAIN_SHIFT;
+  }
+
+  stats.open_circuit_mv = open_circuit >> SOC_GAIN_SHIFT;
+  stats.resistance_mv = resistance >> SOC_GAIN_SHIFT;
+  stats.load = load;
+  stats.charge = lookup(stats.open_circuit_mv);
+  stats.percent = (stats.charge + (1 << (CHARGE_SHIFT - 1))) >> CHARGE_SHIFT;
+
+  // Only Driving Time Counts Towards the Drain
+  uint16_t elapsed = now - last_update;
+  last_update = now;
+  if (load >= SOC_DRIVING_LOAD)
+  {
+    window_ms += elapsed;
+    window_peak = (load > window_peak) ? load : window_peak;
+    if (window_ms >= SOC_WINDOW_MS)
+    {
+      close_window();
+    }
+  }
+  update_minutes();
+}
+
+// Function to Read the Estimate
+const soc_stats &soc_statistics(void)
+{
+  return stats;
+}
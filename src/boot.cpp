@@ -0,0 +1,145 @@
+// Boot Supervision
+#include <Arduino.h>
+#include "boot.h"
+#include "radio_link.h"
+
+#if defined(__AVR_ATmega32U4__)
+#include <avr/wdt.h>
+#endif
+
+// Boot Statistics
+static boot_stats stats;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+#if defined(__AVR_ATmega32U4__)
+
+// Watchdog Prescaler of BOOT_WATCHDOG_TIMEOUT, as Set in WDTCSR
+static_assert(BOOT_WATCHDOG_TIMEOUT == 250, "the watchdog prescaler below stands for 250 ms");
+static const uint8_t WATCHDOG_TIMEOUT = WDTO_250MS;
+static const uint8_t WATCHDOG_PRESCALER_BITS = (1 << WDP3) | (1 << WDP2) | (1 << WDP1) | (1 << WDP0);
+static const uint8_t WATCHDOG_PRESCALER = WATCHDOG_TIMEOUT & 0x07;
+
+// Reset Flags, Saved Before the C Runtime Starts (Left Out of its Zeroing)
+static uint8_t reset_flags __attribute__((section(".noinit")));
+
+// Function Run Before the C Runtime: Saves and Clears the Reset Flags, Stops a Watchdog Left Running by its Reset
+static void save_reset_flags(void) __attribute__((naked, used, section(".init3")));
+static void save_reset_flags(void)
+{
+  reset_flags = MCUSR;
+  MCUSR = 0;
+  wdt_disable();
+}
+
+// Function to Start the Boot Supervision
+void boot_begin(void)
+{
+  memset(&stats, 0xFF, sizeof(stats));
+  stats.reset_reason = reset_flags & (BOOT_RESET_POWER_ON | BOOT_RESET_EXTERNAL | BOOT_RESET_BROWNOUT |
+                                      BOOT_RESET_WATCHDOG | BOOT_RESET_JTAG);
+  stats.radio_attempts = 0;
+  boot_mark(BOOT_SETUP);
+  wdt_enable(WATCHDOG_TIMEOUT);
+}
+
+// Function to Pet the Watchdog
+void boot_watchdog_pet(void)
+{
+  uint8_t control = WDTCSR;
+  if (!(control & (1 << WDE)))
+  {
+    // Stopped by Someone Else (an Upload Request Called Off), Armed Again
+    wdt_enable(WATCHDOG_TIMEOUT);
+  }
+  else if ((control & WATCHDOG_PRESCALER_BITS) == WATCHDOG_PRESCALER)
+  {
+    // Only Our Own Timeout, a Different One is Left to Expire
+    wdt_reset();
+  }
+}
+
+#else
+
+// Function to Start the Boot Supervision (Host Builds Always Start From Power On, Without a Watchdog)
+void boot_begin(void)
+{
+  memset(&stats, 0xFF, sizeof(stats));
+  stats.reset_reason = BOOT_RESET_POWER_ON;
+  stats.radio_attempts = 0;
+  boot_mark(BOOT_SETUP);
+}
+
+// Function to Pet the Watchdog
+void boot_watchdog_pet(void)
+{
+}
+
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Stamp a Milestone
+bool boot_mark(uint8_t stage)
+{
+  if (stats.stage_ms[stage] != BOOT_NOT_REACHED)
+  {
+    return false;
+  }
+  unsigned long now = millis();
+  stats.stage_ms[stage] = (now < BOOT_NOT_REACHED) ? now : BOOT_NOT_REACHED - 1;
+  return true;
+}
+
+// Function to Bring the Radio Up
+bool boot_radio(uint8_t attempts)
+{
+  for (uint8_t i = 0; i < attempts; i++)
+  {
+    boot_watchdog_pet();
+    if (stats.radio_attempts < 0xFF)
+    {
+      stats.radio_attempts++;
+    }
+    if (radio_link_begin(boot_watchdog_pet))
+    {
+      boot_mark(BOOT_RADIO);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Function to Read the Boot Statistics
+const boot_stats &boot_statistics(void)
+{
+  return stats;
+}
+
+// Function to Print the Boot Statistics
+void boot_report(void)
+{
+  static const char *const STAGE_NAMES[NUMBER_BOOT_STAGES] = {"setup", "motors", "radio", "ready", "first packet"};
+
+  Serial.print(F("Boot: reset flags "));
+  Serial.print(stats.reset_reason);
+  Serial.print(F(", radio attempts "));
+  Serial.println(stats.radio_attempts);
+  for (uint8_t i = 0; i < NUMBER_BOOT_STAGES; i++)
+  {
+    Serial.print(F("  "));
+    Serial.print(STAGE_NAMES[i]);
+    Serial.print(F(" at "));
+    if (stats.stage_ms[i] == BOOT_NOT_REACHED)
+    {
+      Serial.println(F("-"));
+    }
+    else
+    {
+      Serial.print(stats.stage_ms[i]);
+      Serial.println(F(" ms"));
+    }
+  }
+}
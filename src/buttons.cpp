@@ -0,0 +1,91 @@
+// Controller Buttons Debouncer
+#include <Arduino.h>
+#include "buttons.h"
+
+// Debouncer State
+static uint8_t state = 0;
+static uint8_t held = 0;
+static uint8_t count0 = 0xFF;
+static uint8_t count1 = 0xFF;
+static unsigned long last_tick = 0;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Pack the Buttons Readings
+uint8_t buttons_pack(const controller_variables &controller)
+{
+  uint8_t readings = 0;
+  readings |= controller.button1_reading ? 0x01 : 0;
+  readings |= controller.button2_reading ? 0x02 : 0;
+  readings |= controller.button3_reading ? 0x04 : 0;
+  readings |= controller.button4_reading ? 0x08 : 0;
+  readings |= controller.button5_reading ? 0x10 : 0;
+  readings |= controller.button6_reading ? 0x20 : 0;
+  return readings;
+}
+
+// Function to Debounce the Buttons
+button_edges buttons_update(uint8_t readings, unsigned long now)
+{
+  button_edges edges = {0, 0};
+
+  // Runs the Ticks Elapsed Since the Last Update on the Reading Held Meanwhile
+  uint8_t ticks = 0;
+  while ((now - last_tick) >= DEBOUNCE_TICK)
+  {
+    last_tick += DEBOUNCE_TICK;
+    if (ticks == 4)
+    {
+      // Counters Are Settled After Four Ticks, Skips the Rest of a Long Gap
+      last_tick = now;
+      break;
+    }
+    ticks++;
+
+    // Vertical Counter: Counts Down While a Reading Differs, Toggles the State on Roll Over
+    uint8_t changed = state ^ held;
+    count0 = ~(count0 & changed);
+    count1 = count0 ^ (count1 & changed);
+    changed &= count0 & count1;
+    state ^= changed;
+    edges.pressed |= state & changed;
+    edges.released |= ~state & changed;
+  }
+
+  // New Reading Counts from the Next Tick On
+  held = readings;
+  return edges;
+}
+
+// Function to Read the Debounced State
+uint8_t buttons_state(void)
+{
+  return state;
+}
+
+// Function to Run the Buttons Actions
+void buttons_dispatch(const button_edges &edges, const button_action *actions)
+{
+  uint8_t changed = edges.pressed | edges.released;
+  for (uint8_t i = 0; changed != 0; i++, changed >>= 1)
+  {
+    if ((changed & 0x01) == 0)
+    {
+      continue;
+    }
+    void (*action)(void);
+    if (edges.pressed & (1 << i))
+    {
+      action = (void (*)(void))pgm_read_ptr(&actions[i].pressed);
+    }
+    else
+    {
+      action = (void (*)(void))pgm_read_ptr(&actions[i].released);
+    }
+    if (action != NULL)
+    {
+      action();
+    }
+  }
+}
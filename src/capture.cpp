@@ -0,0 +1,35 @@
+// Controller Stream Capture
+#include <Arduino.h>
+#include "capture.h"
+
+// Function to Write the Capture Header
+void capture_begin(void)
+{
+  Serial.println(F(CAPTURE_MAGIC));
+  Serial.println(F(CAPTURE_COLUMNS));
+}
+
+// Function to Write One Packet
+void capture_packet(const controller_variables &controller, const radio_link_packet &packet, uint16_t battery)
+{
+  const uint8_t buttons[6] = {controller.button1_reading, controller.button2_reading, controller.button3_reading,
+                              controller.button4_reading, controller.button5_reading, controller.button6_reading};
+  const uint16_t analogs[7] = {controller.X1axis_reading, controller.Y1axis_reading, controller.X2axis_reading,
+                               controller.Y2axis_reading, controller.slider1_reading, controller.slider2_reading,
+                               battery};
+
+  Serial.print(packet.received_at);
+  Serial.print(',');
+  Serial.print(packet.sequence);
+  for (uint8_t i = 0; i < 6; i++)
+  {
+    Serial.print(',');
+    Serial.print(buttons[i] ? 1 : 0);
+  }
+  for (uint8_t i = 0; i < 7; i++)
+  {
+    Serial.print(',');
+    Serial.print(analogs[i]);
+  }
+  Serial.println();
+}
@@ -0,0 +1,253 @@
+// Radio Channel Hopping Plan
+#include <Arduino.h>
+#include "channel_hopping.h"
+
+// Mask With Every Channel of the Plan
+static const uint8_t FULL_MASK = (uint8_t)((1U << HOP_CHANNELS) - 1);
+
+// Plan and Active Channels (Plan Slots in Hopping Order)
+static hop_plan plan;
+static uint8_t active[HOP_CHANNELS];
+static uint8_t active_count;
+
+// Announced Mask Waiting for its Sequence Number
+static bool pending = false;
+static uint8_t pending_mask;
+
+// Sequence Tracking
+static bool synced = false;
+static uint8_t last_sequence;
+static uint32_t last_time;
+static uint8_t expected;
+static uint32_t deadline;
+static uint32_t interval = 0;
+static uint16_t evaluated;
+
+// Statistics
+static hop_stats stats;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to List the Channels Enabled by a Mask
+static void set_mask(uint8_t mask)
+{
+  plan.mask = mask;
+  active_count = 0;
+  for (uint8_t i = 0; i < HOP_CHANNELS; i++)
+  {
+    if (mask & (1 << i))
+    {
+      active[active_count++] = i;
+    }
+  }
+  stats.mask = mask;
+}
+
+// Function to Find the Plan Slot a Sequence Number is Sent On
+static inline uint8_t slot_for(uint8_t sequence)
+{
+  return active[(sequence >> HOP_DWELL_SHIFT) % active_count];
+}
+
+// Function to Find the Channel a Sequence Number is Sent On
+static uint8_t channel_for(uint8_t sequence)
+{
+  return stats.hopping ? plan.channels[slot_for(sequence)] : HOP_RENDEZVOUS_CHANNEL;
+}
+
+// Function to Go Back to the Rendezvous Channel and the Full Plan
+static void enter_rendezvous(void)
+{
+  stats.hopping = false;
+  stats.channel = HOP_RENDEZVOUS_CHANNEL;
+  synced = false;
+  pending = false;
+  evaluated = 0;
+  set_mask(FULL_MASK);
+  for (uint8_t i = 0; i < HOP_CHANNELS; i++)
+  {
+    stats.heard[i] = 0;
+    stats.missed[i] = 0;
+  }
+}
+
+// Function to Switch to an Announced Mask Once its Sequence Number Comes
+static void apply_pending(uint8_t next)
+{
+  if (pending && (int8_t)(next - plan.apply_sequence) >= 0)
+  {
+    set_mask(pending_mask);
+    pending = false;
+    stats.hopping = true;
+  }
+}
+
+// Function to Drop the Channels Losing Too Many Packets
+static void evaluate_channels(void)
+{
+  uint8_t mask = plan.mask;
+  uint8_t remaining = active_count;
+  for (uint8_t i = 0; i < HOP_CHANNELS; i++)
+  {
+    uint16_t total = stats.heard[i] + stats.missed[i];
+    if ((mask & (1 << i)) && remaining > HOP_MIN_CHANNELS && total > 0 && stats.missed[i] > (total >> 2))
+    {
+      mask &= ~(1 << i);
+      remaining--;
+      stats.drops++;
+    }
+
+    // Ages the Counters so Recent Losses Weigh More
+    stats.heard[i] >>= 1;
+    stats.missed[i] >>= 1;
+  }
+  evaluated = 0;
+
+  if (mask != plan.mask)
+  {
+    pending = true;
+    pending_mask = mask;
+    plan.apply_sequence = last_sequence + HOP_ANNOUNCE_LEAD;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Build the Plan from the Channel Survey
+void hopping_begin(const uint8_t *busy)
+{
+  // Takes the Quietest Channels Not Adjacent to Each Other Nor to the Rendezvous Channel
+  for (uint8_t n = 0; n < HOP_CHANNELS; n++)
+  {
+    uint8_t best = HOP_SURVEY_COUNT;
+    for (uint8_t i = 0; i < HOP_SURVEY_COUNT; i++)
+    {
+      uint8_t channel = HOP_SURVEY_FIRST + i;
+      bool near = (channel + 1 >= HOP_RENDEZVOUS_CHANNEL) && (channel <= HOP_RENDEZVOUS_CHANNEL + 1);
+      for (uint8_t j = 0; j < n && !near; j++)
+      {
+        near = (channel + 1 >= plan.channels[j]) && (channel <= plan.channels[j] + 1);
+      }
+      if (!near && (best == HOP_SURVEY_COUNT || busy[i] < busy[best]))
+      {
+        best = i;
+      }
+    }
+    plan.channels[n] = HOP_SURVEY_FIRST + best;
+  }
+
+  stats.resyncs = 0;
+  stats.drops = 0;
+  stats.coasts = 0;
+  interval = 0;
+  enter_rendezvous();
+}
+
+// Function to Record a Valid Packet
+uint8_t hopping_received(uint8_t sequence, uint32_t now)
+{
+  if (synced)
+  {
+    uint8_t gap = sequence - last_sequence;
+    if (gap == 0 || gap > 128)
+    {
+      // Repeated or Late Packet
+      return stats.channel;
+    }
+
+    // Packet Interval Average (1/8 Weight), Only From Back to Back Packets
+    if (gap == 1)
+    {
+      uint32_t elapsed = now - last_time;
+      interval = (interval == 0) ? elapsed : interval - (interval >> 3) + (elapsed >> 3);
+    }
+
+    // Charges the Packets Never Heard to the Channels They Were Sent On
+    if (stats.hopping)
+    {
+      for (uint8_t q = last_sequence + 1; q != sequence; q++)
+      {
+        stats.missed[slot_for(q)]++;
+      }
+      evaluated += gap - 1;
+    }
+  }
+  if (stats.hopping)
+  {
+    stats.heard[slot_for(sequence)]++;
+    evaluated++;
+  }
+  last_sequence = sequence;
+  last_time = now;
+  synced = true;
+
+  // Announces the Full Plan on the Rendezvous Channel
+  if (!stats.hopping && !pending)
+  {
+    pending = true;
+    pending_mask = FULL_MASK;
+    plan.apply_sequence = sequence + HOP_ANNOUNCE_LEAD;
+  }
+  else if (stats.hopping && !pending && evaluated >= HOP_EVALUATE_PACKETS)
+  {
+    evaluate_channels();
+  }
+
+  // Listens Where the Next Packet Will be Sent
+  expected = sequence + 1;
+  deadline = now + interval + (interval >> 1);
+  apply_pending(expected);
+  stats.channel = channel_for(expected);
+  return stats.channel;
+}
+
+// Function to Follow the Plan While Packets are Missing
+uint8_t hopping_update(uint32_t now)
+{
+  if (!synced)
+  {
+    return stats.channel;
+  }
+
+  // Lost Each Other, Meets Again at the Rendezvous Channel
+  if (now - last_time > HOP_RESYNC_TIMEOUT_US)
+  {
+    if (stats.hopping)
+    {
+      stats.resyncs++;
+    }
+    enter_rendezvous();
+    return stats.channel;
+  }
+
+  // Moves On with the Controller, Which Keeps Sending at the Same Rate
+  if (interval > 0 && (int32_t)(now - deadline) >= 0)
+  {
+    expected++;
+    deadline += interval;
+    stats.coasts++;
+    apply_pending(expected);
+    stats.channel = channel_for(expected);
+  }
+  return stats.channel;
+}
+
+// Function to Get the Plan to Announce
+bool hopping_announcement(hop_plan &announcement)
+{
+  if (!pending)
+  {
+    return false;
+  }
+  announcement = plan;
+  announcement.mask = pending_mask;
+  return true;
+}
+
+// Function to Read the Hopping Statistics
+const hop_stats &hopping_statistics(void)
+{
+  return stats;
+}
@@ -0,0 +1,98 @@
+// Wheel Encoders
+#include <Arduino.h>
+#include "encoders.h"
+#include "motor_driver.h"
+
+#if defined(__AVR_ATmega32U4__)
+#include <util/atomic.h>
+#define ENCODERS_ATOMIC() ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+#else
+#define ENCODERS_ATOMIC()
+#endif
+
+// Encoder Pin of Each Wheel
+static const uint8_t PINS[NUMBER_WHEELS] = {
+    ENCODER_PIN_FRONT_LEFT,
+    ENCODER_PIN_FRONT_RIGHT,
+    ENCODER_PIN_BACK_LEFT,
+    ENCODER_PIN_BACK_RIGHT,
+};
+
+// Encoder Pins Must Leave the Direction Pins and the Radio IRQ Line Alone
+#define ENCODER_PIN_FREE(pin, taken) ((pin) == ENCODER_NONE || (pin) != (taken))
+#define ENCODER_PINS_FREE(taken)                                                                                      \
+  (ENCODER_PIN_FREE(ENCODER_PIN_FRONT_LEFT, taken) && ENCODER_PIN_FREE(ENCODER_PIN_FRONT_RIGHT, taken) &&             \
+   ENCODER_PIN_FREE(ENCODER_PIN_BACK_LEFT, taken) && ENCODER_PIN_FREE(ENCODER_PIN_BACK_RIGHT, taken))
+static_assert(ENCODER_PINS_FREE(PIN_DIRA), "an encoder pin takes the DIRA pin, move the jumper (MOTOR_PIN_DIRA)");
+static_assert(ENCODER_PINS_FREE(PIN_DIRC), "an encoder pin takes the DIRC pin, move the jumper (MOTOR_PIN_DIRC)");
+#ifdef RADIO_IRQ_PIN
+static_assert(ENCODER_PINS_FREE(RADIO_IRQ_PIN), "an encoder pin takes the radio IRQ pin");
+#endif
+
+// Edges Counted Since the Last Read (Saturating, a Read Comes Every Control Tick)
+static volatile uint8_t counts[NUMBER_WHEELS];
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Encoder Interrupt Handlers
+template <uint8_t WHEEL>
+static void encoder_interrupt(void)
+{
+  if (counts[WHEEL] != 0xFF)
+  {
+    counts[WHEEL]++;
+  }
+}
+static void (*const HANDLERS[NUMBER_WHEELS])(void) = {
+    encoder_interrupt<WHEEL_FRONT_LEFT>,
+    encoder_interrupt<WHEEL_FRONT_RIGHT>,
+    encoder_interrupt<WHEEL_BACK_LEFT>,
+    encoder_interrupt<WHEEL_BACK_RIGHT>,
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Attach the Encoders
+uint8_t encoders_begin(void)
+{
+  uint8_t attached = 0;
+  for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+  {
+    counts[i] = 0;
+    if (PINS[i] == ENCODER_NONE)
+    {
+      continue;
+    }
+    int8_t interrupt = digitalPinToInterrupt(PINS[i]);
+    if (interrupt < 0)
+    {
+      continue;
+    }
+    pinMode(PINS[i], INPUT_PULLUP);
+    attachInterrupt(interrupt, HANDLERS[i], CHANGE);
+    attached |= (1 << i);
+  }
+  return attached;
+}
+
+// Function to Take the Counted Edges
+void encoders_read(uint8_t edges[NUMBER_WHEELS])
+{
+  ENCODERS_ATOMIC()
+  {
+    for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+    {
+      edges[i] = counts[i];
+      counts[i] = 0;
+    }
+  }
+}
+
+// Function to Drop the Counted Edges
+void encoders_clear(void)
+{
+  uint8_t edges[NUMBER_WHEELS];
+  encoders_read(edges);
+}
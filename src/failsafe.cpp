@@ -0,0 +1,108 @@
+// Command Failsafe Tiers
+#include <Arduino.h>
+#include "failsafe.h"
+
+// Newest Accepted Packet
+static bool synced = false;
+static uint8_t last_sequence;
+static uint32_t last_received;
+
+// Hold Time From the Measured Packet Interval
+static uint32_t hold_us = FAILSAFE_HOLD_MAX_US;
+
+// Statistics
+static failsafe_stats stats;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Start the Failsafe
+void failsafe_begin(void)
+{
+  synced = false;
+  hold_us = FAILSAFE_HOLD_MAX_US;
+  stats.tier = FAILSAFE_STOP;
+  stats.interval_us = 0;
+}
+
+// Function to Offer a Received Packet
+bool failsafe_packet(uint8_t sequence, uint32_t received_at)
+{
+  if (synced && stats.tier != FAILSAFE_STOP)
+  {
+    // Repeated or Late Packets (a Bounded Window Behind the Newest) Never Restart the Failsafe
+    uint8_t advance = sequence - last_sequence;
+    if (advance == 0 || advance > (uint8_t)(0xFF - FAILSAFE_LATE_PACKETS))
+    {
+      stats.rejected++;
+      return false;
+    }
+
+    if (advance > FAILSAFE_ADVANCE_MAX)
+    {
+      // Further Back Than Late: the Controller Restarted its Sequence, Followed From Here Without Measuring
+      stats.resyncs++;
+    }
+    else
+    {
+      // Lost Packets Bridged by Holding the Last Command
+      if (advance > 1 && stats.tier == FAILSAFE_DRIVE)
+      {
+        stats.holds++;
+      }
+
+      // Packet Interval Average (1/8 Weight) Over the Packets Sent Meanwhile
+      uint32_t interval = (received_at - last_received) / advance;
+      stats.interval_us = (stats.interval_us == 0) ? interval
+                                                   : stats.interval_us - (stats.interval_us >> 3) + (interval >> 3);
+      hold_us = stats.interval_us * FAILSAFE_HOLD_PACKETS;
+      hold_us = constrain(hold_us, FAILSAFE_HOLD_MIN_US, FAILSAFE_HOLD_MAX_US);
+    }
+  }
+
+  last_sequence = sequence;
+  last_received = received_at;
+  synced = true;
+  return true;
+}
+
+// Function to Find the Tier for the Current Time
+uint8_t failsafe_update(uint32_t now)
+{
+  if (!synced)
+  {
+    return stats.tier;
+  }
+
+  uint32_t silence = now - last_received;
+  uint8_t tier = FAILSAFE_DRIVE;
+  if (silence >= FAILSAFE_STOP_US)
+  {
+    tier = FAILSAFE_STOP;
+  }
+  else if (silence >= hold_us)
+  {
+    tier = FAILSAFE_DECEL;
+  }
+
+  // Counts Every Entry into the Slowing Tiers
+  if (tier != stats.tier)
+  {
+    if (tier == FAILSAFE_DECEL)
+    {
+      stats.decels++;
+    }
+    else if (tier == FAILSAFE_STOP)
+    {
+      stats.stops++;
+    }
+    stats.tier = tier;
+  }
+  return tier;
+}
+
+// Function to Read the Failsafe Statistics
+const failsafe_stats &failsafe_statistics(void)
+{
+  return stats;
+}
@@ -0,0 +1,116 @@
+// Robot Lights Frame Renderer
+#include <Arduino.h>
+#include "lights.h"
+
+// Strips Layout
+const uint8_t LIGHT_PIXELS = 8;
+const uint16_t HALF_FIRST = 0x00FF;
+const uint16_t HALF_SECOND = 0xFF00;
+
+// Palette Indexes (2 Bits per Pixel)
+const uint8_t COLOR_OFF = 0;
+const uint8_t COLOR_WHITE = 1;
+const uint8_t COLOR_RED = 2;
+const uint8_t COLOR_ORANGE = 3;
+
+// Lights Colors
+static const uint8_t PALETTE[4][3] PROGMEM = {
+    {0, 0, 0},
+    {255, 255, 255},
+    {255, 0, 0},
+    {255, 175, 0},
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Frame Builders (Evaluated at Compile Time)
+constexpr uint16_t solid(uint8_t color)
+{
+  // Unsigned, 3 * 0x5555 Overflows the 16-bit int of the AVR and Would Leave FRAMES Built at Run Time
+  return (uint16_t)(color * 0x5555u);
+}
+static_assert(solid(COLOR_ORANGE) == 0xFFFF, "frames must be built at compile time");
+
+constexpr uint16_t blinker(uint16_t frame, bool enabled, bool phase, uint16_t half)
+{
+  return enabled ? (uint16_t)((frame & ~half) | (phase ? (solid(COLOR_ORANGE) & half) : 0)) : frame;
+}
+
+constexpr uint16_t front_frame(uint8_t state)
+{
+  return blinker(blinker((state & LIGHT_FRONT) ? solid(COLOR_WHITE) : 0, state & LIGHT_BLINK_RIGHT,
+                         state & LIGHT_BLINK_PHASE, HALF_SECOND),
+                 state & LIGHT_BLINK_LEFT, state & LIGHT_BLINK_PHASE, HALF_FIRST);
+}
+
+constexpr uint16_t back_frame(uint8_t state)
+{
+  return blinker(blinker((state & LIGHT_BACK) ? solid(COLOR_RED) : 0, state & LIGHT_BLINK_RIGHT,
+                         state & LIGHT_BLINK_PHASE, HALF_FIRST),
+                 state & LIGHT_BLINK_LEFT, state & LIGHT_BLINK_PHASE, HALF_SECOND);
+}
+
+// Precomputed Frames Indexed by Lights State ({front, back})
+#define LIGHT_FRAME(s) {front_frame(s), back_frame(s)}
+#define LIGHT_FRAMES_4(s) LIGHT_FRAME(s), LIGHT_FRAME(s + 1), LIGHT_FRAME(s + 2), LIGHT_FRAME(s + 3)
+#define LIGHT_FRAMES_16(s) LIGHT_FRAMES_4(s), LIGHT_FRAMES_4(s + 4), LIGHT_FRAMES_4(s + 8), LIGHT_FRAMES_4(s + 12)
+static const uint16_t FRAMES[NUMBER_LIGHT_STATES][2] PROGMEM = {LIGHT_FRAMES_16(0), LIGHT_FRAMES_16(16)};
+
+// Strips and Shown Frames
+static Adafruit_NeoPixel *strips[2];
+static uint16_t shown[2];
+static unsigned long last_show = 0;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Bind the Renderer to the Strips
+void lights_begin(Adafruit_NeoPixel *front, Adafruit_NeoPixel *back)
+{
+  strips[0] = front;
+  strips[1] = back;
+  shown[0] = shown[1] = 0;
+}
+
+// Function to Render the Lights State
+bool lights_render(uint8_t state, unsigned long now)
+{
+  // Looks Up the Frames of the State
+  uint16_t pending[2];
+  for (uint8_t s = 0; s < 2; s++)
+  {
+    pending[s] = pgm_read_word(&FRAMES[state & (NUMBER_LIGHT_STATES - 1)][s]);
+  }
+
+  // Nothing to Do in Steady State
+  if (pending[0] == shown[0] && pending[1] == shown[1])
+  {
+    return false;
+  }
+
+  // Limits the Refresh Rate
+  if ((now - last_show) < LIGHTS_REFRESH_INTERVAL)
+  {
+    return false;
+  }
+  last_show = now;
+
+  // Decodes and Pushes Only the Strips That Changed
+  for (uint8_t s = 0; s < 2; s++)
+  {
+    if (pending[s] == shown[s])
+    {
+      continue;
+    }
+    uint16_t frame = pending[s];
+    for (uint8_t i = 0; i < LIGHT_PIXELS; i++)
+    {
+      const uint8_t *color = PALETTE[(frame >> (2 * i)) & 0x03];
+      strips[s]->setPixelColor(i, pgm_read_byte(&color[0]), pgm_read_byte(&color[1]), pgm_read_byte(&color[2]));
+    }
+    strips[s]->show();
+    shown[s] = frame;
+  }
+  return true;
+}
@@ -0,0 +1,173 @@
+// Radio Link Profile Manager
+#include <Arduino.h>
+#include <RF24.h>
+#include "link_manager.h"
+
+// Data Rate and Power of Each Profile
+static const link_profile PROFILES[LINK_PROFILES] PROGMEM = {
+    {RF24_250KBPS, RF24_PA_MAX},
+    {RF24_1MBPS, RF24_PA_HIGH},
+    {RF24_2MBPS, RF24_PA_HIGH},
+    {RF24_2MBPS, RF24_PA_LOW},
+};
+
+// Current Window
+static uint8_t window_packets;
+static uint8_t window_lost;
+static uint8_t window_retries;
+static uint8_t window_strong;
+static uint8_t clean_windows;
+static uint8_t required_clean;
+static bool stepped_up;
+
+// Last Packet Time
+static uint32_t last_time;
+static bool heard = false;
+
+// Statistics
+static link_stats stats;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Start a New Window
+static void reset_window(void)
+{
+  window_packets = 0;
+  window_lost = 0;
+  window_retries = 0;
+  window_strong = 0;
+}
+
+// Function to Add to a Window Counter Without Wrapping
+static inline void add_saturated(uint8_t &counter, uint8_t value)
+{
+  counter = (counter > 255 - value) ? 255 : counter + value;
+}
+
+// Function to Announce a Profile to Both Ends
+static void announce(uint8_t profile, uint8_t sequence)
+{
+  stats.announced = profile;
+  stats.apply_sequence = sequence + LINK_ANNOUNCE_LEAD;
+  clean_windows = 0;
+}
+
+// Function to Judge a Full Window
+static void evaluate_window(uint8_t sequence)
+{
+  bool failed = window_lost > LINK_LOSS_LIMIT || window_retries > LINK_RETRIES_LIMIT;
+  if (failed)
+  {
+    if (stats.profile > LINK_ROBUST)
+    {
+      announce(stats.profile - 1, sequence);
+      stats.step_downs++;
+    }
+
+    // Backs Off From a Profile That Failed as Soon as it Was Reached
+    if (stepped_up)
+    {
+      required_clean = (required_clean > LINK_CLEAN_WINDOWS_MAX / 2) ? LINK_CLEAN_WINDOWS_MAX : required_clean * 2;
+    }
+    clean_windows = 0;
+  }
+  else if (window_lost <= LINK_LOSS_CLEAN && window_retries <= LINK_RETRIES_CLEAN && window_strong >= LINK_STRONG_MIN)
+  {
+    if (++clean_windows >= required_clean && stats.profile + 1 < LINK_PROFILES)
+    {
+      announce(stats.profile + 1, sequence);
+      stats.step_ups++;
+    }
+  }
+  else
+  {
+    clean_windows = 0;
+  }
+
+  // A Step Up That Held for a Window Clears the Back Off
+  if (stepped_up && !failed)
+  {
+    required_clean = LINK_CLEAN_WINDOWS;
+  }
+  stepped_up = false;
+  reset_window();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Start the Link Manager
+void link_begin(void)
+{
+  stats.profile = LINK_ROBUST;
+  stats.announced = LINK_ROBUST;
+  stats.apply_sequence = 0;
+  clean_windows = 0;
+  required_clean = LINK_CLEAN_WINDOWS;
+  stepped_up = false;
+  heard = false;
+  reset_window();
+}
+
+// Function to Read the Radio Settings of a Profile
+link_profile link_settings(uint8_t profile)
+{
+  link_profile settings;
+  memcpy_P(&settings, &PROFILES[(profile < LINK_PROFILES) ? profile : LINK_ROBUST], sizeof(settings));
+  return settings;
+}
+
+// Function to Record a Valid Packet
+uint8_t link_received(uint8_t sequence, uint8_t lost, uint8_t retries, bool strong, uint32_t now)
+{
+  last_time = now;
+  heard = true;
+
+  // Both Ends Switch Once the Controller Reaches the Announced Sequence
+  if (stats.announced != stats.profile)
+  {
+    if ((int8_t)(sequence + 1 - stats.apply_sequence) >= 0)
+    {
+      stepped_up = stats.announced > stats.profile;
+      stats.profile = stats.announced;
+      reset_window();
+    }
+    return stats.profile;
+  }
+
+  add_saturated(window_lost, lost);
+  add_saturated(window_retries, retries);
+  window_strong += strong ? 1 : 0;
+  if (++window_packets >= LINK_WINDOW_PACKETS)
+  {
+    evaluate_window(sequence);
+  }
+  return stats.profile;
+}
+
+// Function to Fall Back When the Link Goes Silent
+uint8_t link_update(uint32_t now)
+{
+  if (heard && now - last_time > LINK_FALLBACK_TIMEOUT_US)
+  {
+    // Also Withdraws a Pending Announcement the Controller May Never Have Heard
+    if (stats.profile != LINK_ROBUST)
+    {
+      stats.fallbacks++;
+    }
+    stats.profile = LINK_ROBUST;
+    stats.announced = LINK_ROBUST;
+    heard = false;
+    clean_windows = 0;
+    stepped_up = false;
+    reset_window();
+  }
+  return stats.profile;
+}
+
+// Function to Read the Link Statistics
+const link_stats &link_statistics(void)
+{
+  return stats;
+}
@@ -15,46 +15,45 @@
 // Debug Macro
 // #define DEBUG
 
-// Libraries
-#include <SPI.h>
-#include <RF24.h>
-#include <printf.h>
-#include <Adafruit_NeoPixel.h>
-
-// Radio Controller Object
-RF24 radio(11, 12);
+// Profiling Macro (Binary Reports, Not Meant to be Combined with DEBUG)
+// #define PROFILE
 
-// Radios Addresses
-uint8_t address[][6] = {"Ctrlr", "Robot"};
+// Capture Macro (CSV Stream of the Received Packets for the Host Replay, Not Meant to be Combined with the Others)
+// #define CAPTURE
 
-// Radio Number
-const bool radio_number = 1;
-
-// Variables structure
-typedef struct
-{
-  uint8_t button1_reading;
-  uint8_t button2_reading;
-  uint8_t button3_reading;
-  uint8_t button4_reading;
-  uint8_t button5_reading;
-  uint8_t button6_reading;
-  uint16_t X1axis_reading;
-  uint16_t Y1axis_reading;
-  uint16_t X2axis_reading;
-  uint16_t Y2axis_reading;
-  uint16_t slider1_reading;
-  uint16_t slider2_reading;
-} controller_variables;
+// Libraries
+#include <Adafruit_NeoPixel.h>
+#include "controller.h"
+#include "radio_link.h"
+#include "radio_frame.h"
+#include "mixer.h"
+#include "sticks.h"
+#include "ramp.h"
+#include "encoders.h"
+#include "speed_control.h"
+#include "voltage_compensation.h"
+#include "failsafe.h"
+#include "motor_driver.h"
+#include "lights.h"
+#include "battery.h"
+#include "battery_soc.h"
+#include "buttons.h"
+#include "scheduler.h"
+#include "profiler.h"
+#include "telemetry.h"
+#include "channel_hopping.h"
+#include "link_manager.h"
+#include "capture.h"
+#include "robot_state.h"
+#include "boot.h"
+#include "power.h"
+
+// Controller Readings
 controller_variables controller;
 
 // Variables for Message Receptions
-uint8_t channel;
-uint8_t bytes;
-
-// Variables For Failsafe
-unsigned long last_message = 0;
-const uint16_t FAILSAFE_INTERVAL = 2000;
+radio_link_packet packet;
+const uint8_t bytes = sizeof(radio_frame);
 
 // WS2812B LEDs Module Control Variables
 const uint8_t PIN_LED1 = A0;
@@ -65,30 +64,24 @@ const uint8_t NUMBER_LED = 8;
 Adafruit_NeoPixel LED_BACK(NUMBER_LED, PIN_LED1, NEO_GRB + NEO_KHZ800);
 Adafruit_NeoPixel LED_FRONT(NUMBER_LED, PIN_LED2, NEO_GRB + NEO_KHZ800);
 
-// L298P Direction Control Pins
-const uint8_t PIN_DIRA = 3;
-const uint8_t PIN_DIRB = 4;
-const uint8_t PIN_DIRC = 7;
-const uint8_t PIN_DIRD = 8;
-
-// L298P Enable Control Pins
-const uint8_t PIN_ENA = 6;
-const uint8_t PIN_ENB = 5;
-const uint8_t PIN_ENC = 10;
-const uint8_t PIN_END = 9;
-
-// Speed (PWM) Variable
-const uint8_t stop_speed = 0;
-const uint16_t speed_min = 80;
-uint16_t speed_max = 145;
-int vertical = 0;
-int horizontal = 0;
-int difference = 0;
-int sum = 0;
-int sub = 0;
-
-// Control Mode Variable
-bool mode = true;
+// Speed (PWM) Limits
+const uint8_t speed_min = 80;
+const uint8_t SPEED_MAX_START = 145;
+const drive_command REST_COMMAND = {{0, 0, 0, 0}};
+
+// Stick Response Curves (CURVE_EXPO Softens the Center of an Axis)
+const uint8_t STICK_CURVES[NUMBER_AXES] = {CURVE_LINEAR, CURVE_LINEAR, CURVE_LINEAR, CURVE_LINEAR};
+
+// Control Rate and Wheel Ramps
+const uint16_t CONTROL_RATE = 500;
+const ramp_profile DRIVE_RAMP = RAMP_NORMAL;
+
+// Wheel Speed Controller Gains (Only Wheels With an Encoder Pin Run Closed Loop)
+const speed_gains WHEEL_GAINS = SPEED_GAINS_DEFAULT;
+
+// Radio Start Attempts at Boot, Then One Attempt Every Retry Period Until it Starts
+const uint8_t RADIO_BEGIN_ATTEMPTS = 3;
+const uint16_t RADIO_RETRY_MS = 1000;
 
 // Buzzer Control Pin
 const uint8_t PIN_BUZZER = A2;
@@ -96,73 +89,22 @@ const uint16_t FREQUENCY = 1000;
 
 // Battery Reading Pin
 const uint8_t PIN_BAT = A3;
-uint16_t bat_reading = 0;
-float ADC_voltage = 0.0;
-float bat_voltage = 0.0;
-const float R1 = 30000.0;
-const float R2 = 7500.0;
-const float min_bat_voltage = 6.8;
-
-// Button Reading Variables
-bool reading_button1;
-bool button1_state;
-bool last_button1_state = 0;
-unsigned long last_debounce_time1;
-
-// Button Reading Variables
-bool reading_button2;
-bool button2_state;
-bool last_button2_state = 0;
-unsigned long last_debounce_time2;
-
-// Button Reading Variables
-bool reading_button3;
-bool button3_state;
-bool last_button3_state = 0;
-unsigned long last_debounce_time3;
-
-// Button Reading Variables
-bool reading_button4;
-bool button4_state;
-bool last_button4_state = 0;
-unsigned long last_debounce_time4;
-
-// Button Reading Variables
-bool reading_button5;
-bool button5_state;
-bool last_button5_state = 0;
-unsigned long last_debounce_time5;
-
-// Button Reading Variables
-bool reading_button6;
-bool button6_state;
-bool last_button6_state = 0;
-unsigned long last_debounce_time6;
-
-// Button Debounce
-const uint8_t DEBOUNCE_TIME = 100;
-
-// Lights Control Variables
-bool front_light = false;
-bool back_light = false;
-bool enable_blink = false;
-bool blink_right = false;
-bool blink_left = false;
-
-// Lights Colors Variables
-const uint16_t WHITE_LIGHT[3] = {255, 255, 255};
-const uint16_t RED_LIGHT[3] = {255, 0, 0};
-const uint16_t ORANGE_LIGHT[3] = {255, 175, 0};
-
-// Light Blink Variables
-bool blink = true;
-unsigned long blink_time = 0;
+constexpr float min_bat_voltage = 6.8;
+constexpr uint16_t min_bat_reading = battery_counts(min_bat_voltage);
+
+// Light Blink Interval
 const uint16_t BLINK_INTERVAL = 500;
 
-// Battery reading variables
-unsigned long low_battery_time = 0;
+// Battery Failsafe Delay
 const uint16_t BATTERY_FAILSAFE = 500;
 
+// Battery Warning Sent to the Controller Ahead of the Failsafe (State of Charge or Driving Minutes Left)
+const uint8_t BATTERY_WARNING_PERCENT = 20;
+const uint8_t BATTERY_WARNING_MINUTES = 3;
+
+// Robot Runtime State (Started in setup())
+robot_state robot;
+
 //----------------------------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -170,232 +112,425 @@ const uint16_t BATTERY_FAILSAFE = 500;
 void handle_lights(bool front, bool back, bool right, bool left)
 {
 
-  // Clear LEDs
-  LED_FRONT.clear();
-  LED_BACK.clear();
-
   // Blink Counter
-  if (blink_right || blink_left)
+  if (right || left)
   {
-    if ((millis() - blink_time) > BLINK_INTERVAL)
+    if ((millis() - robot.blink_time) > BLINK_INTERVAL)
     {
-      blink = !blink;
-      blink_time = millis();
+      robot.blink = !robot.blink;
+      robot.blink_time = millis();
     }
   }
 
-  //********************************************************************************************************************
-  // Control Front LEDs
-  if (front)
+  // Renders the Precomputed Frame of the Lights State
+  uint8_t state = 0;
+  state |= front ? LIGHT_FRONT : 0;
+  state |= back ? LIGHT_BACK : 0;
+  state |= right ? LIGHT_BLINK_RIGHT : 0;
+  state |= left ? LIGHT_BLINK_LEFT : 0;
+  state |= robot.blink ? LIGHT_BLINK_PHASE : 0;
+  lights_render(state, millis());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Functions for the Buttons Actions
+void select_mode_2() { robot.mode = false; }
+void select_mode_1() { robot.mode = true; }
+void enable_blinkers() { robot.enable_blink = true; }
+void disable_blinkers() { robot.enable_blink = false; }
+void back_light_on() { robot.back_light = true; }
+void back_light_off() { robot.back_light = false; }
+void front_light_on() { robot.front_light = true; }
+void front_light_off() { robot.front_light = false; }
+void buzzer_on() { digitalWrite(PIN_BUZZER, LOW); }
+void buzzer_off() { digitalWrite(PIN_BUZZER, HIGH); }
+void hazard_light_on() { robot.hazard_light = true; }
+void hazard_light_off() { robot.hazard_light = false; }
+
+// Buttons Actions Table (Pressed, Released)
+const button_action BUTTON_ACTIONS[NUMBER_BUTTONS] PROGMEM = {
+    {select_mode_2, select_mode_1},      // Button 1: Mode Control Changer
+    {enable_blinkers, disable_blinkers}, // Button 2: Light Blink Enabling Changer
+    {back_light_on, back_light_off},     // Button 3: Control the Back Light
+    {front_light_on, front_light_off},   // Button 4: Control the Front Light
+    {buzzer_on, buzzer_off},             // Button 5: Control the Buzzer
+    {hazard_light_on, hazard_light_off}, // Button 6: Hazard Lights (Both Blinkers)
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Radio Task: Takes New Controller Readings
+void radio_task()
+{
+
+  // Ignores the Controller Once the Battery is Low
+  if (!robot.battery_charged)
   {
-    for (uint8_t i = 0; i < NUMBER_LED; i++)
-    {
-      LED_FRONT.setPixelColor(i, LED_FRONT.Color(WHITE_LIGHT[0], WHITE_LIGHT[1], WHITE_LIGHT[2]));
-    }
-    if (blink_right)
-    {
-      if (blink)
-      {
-        for (uint8_t i = 4; i < NUMBER_LED; i++)
-        {
-          LED_FRONT.setPixelColor(i, LED_FRONT.Color(ORANGE_LIGHT[0], ORANGE_LIGHT[1], ORANGE_LIGHT[2]));
-        }
-      }
-      else
-      {
-        for (uint8_t i = 4; i < NUMBER_LED; i++)
-        {
-          LED_FRONT.setPixelColor(i, LED_FRONT.Color(0, 0, 0));
-        }
-      }
-    }
-    if (blink_left)
-    {
-      if (blink)
-      {
-        for (uint8_t i = 0; i < NUMBER_LED / 2; i++)
-        {
-          LED_FRONT.setPixelColor(i, LED_FRONT.Color(ORANGE_LIGHT[0], ORANGE_LIGHT[1], ORANGE_LIGHT[2]));
-        }
-      }
-      else
-      {
-        for (uint8_t i = 0; i < NUMBER_LED / 2; i++)
-        {
-          LED_FRONT.setPixelColor(i, LED_FRONT.Color(0, 0, 0));
-        }
-      }
-    }
+    return;
   }
-  if (blink_right)
+
+  // Retries a Radio That Failed to Start Now and Then, the Robot Stays Stopped Meanwhile
+  if (!robot.radio_ready)
   {
-    if (blink)
+    if ((uint16_t)((uint16_t)millis() - robot.radio_retry_time) >= RADIO_RETRY_MS)
     {
-      for (uint8_t i = 4; i < NUMBER_LED; i++)
-      {
-        LED_FRONT.setPixelColor(i, LED_FRONT.Color(ORANGE_LIGHT[0], ORANGE_LIGHT[1], ORANGE_LIGHT[2]));
-      }
-    }
-    else
-    {
-      for (uint8_t i = 4; i < NUMBER_LED; i++)
-      {
-        LED_FRONT.setPixelColor(i, LED_FRONT.Color(0, 0, 0));
-      }
+      robot.radio_ready = boot_radio(1);
+      robot.radio_listening = robot.radio_ready;
+      robot.radio_retry_time = millis();
     }
+    return;
   }
-  if (blink_left)
+
+  // Listens Only in Short Windows While Idle, Powered Down in Between
+  bool listening = power_radio_window(millis());
+  if (listening != robot.radio_listening)
   {
-    if (blink)
-    {
-      for (uint8_t i = 0; i < NUMBER_LED / 2; i++)
-      {
-        LED_FRONT.setPixelColor(i, LED_FRONT.Color(ORANGE_LIGHT[0], ORANGE_LIGHT[1], ORANGE_LIGHT[2]));
-      }
-    }
-    else
-    {
-      for (uint8_t i = 0; i < NUMBER_LED / 2; i++)
-      {
-        LED_FRONT.setPixelColor(i, LED_FRONT.Color(0, 0, 0));
-      }
-    }
+    radio_link_power(listening);
+    robot.radio_listening = listening;
+  }
+  if (!listening)
+  {
+    return;
   }
 
-  //********************************************************************************************************************
-  // Control Back LEDs
-  if (back)
+  // Checks If New Reading Available
+  PROFILE_BEGIN(PROFILE_RADIO);
+  bool received = radio_link_receive(controller, packet);
+  PROFILE_END(PROFILE_RADIO);
+
+  // Only Packets Newer Than the Last One Restart the Failsafe and Drive the Robot
+  if (received && failsafe_packet(packet.sequence, packet.received_at))
   {
-    for (uint8_t i = 0; i < NUMBER_LED; i++)
+    digitalWrite(LED_BUILTIN, HIGH);
+
+    // Time From Reset to the First Packet (Printed Once on DEBUG)
+#ifdef DEBUG
+    if (boot_mark(BOOT_FIRST_PACKET))
     {
-      LED_BACK.setPixelColor(i, LED_BACK.Color(RED_LIGHT[0], RED_LIGHT[1], RED_LIGHT[2]));
+      boot_report();
     }
-    if (blink_right)
+#else
+    boot_mark(BOOT_FIRST_PACKET);
+#endif
+#ifdef CAPTURE
+    capture_packet(controller, packet, robot.bat_reading >> BATTERY_FILTER_SHIFT);
+#endif
+
+    //******************************************************************************************************************
+    // Debounces the Buttons and Runs the Actions of the Ones That Changed
+    PROFILE_BEGIN(PROFILE_DEBOUNCE);
+    buttons_dispatch(buttons_update(buttons_pack(controller), millis()), BUTTON_ACTIONS);
+    PROFILE_END(PROFILE_DEBOUNCE);
+
+    //******************************************************************************************************************
+    // Speed Max Adjustment (Only When the Sliders Moved)
+    uint16_t sliders = controller.slider1_reading + controller.slider2_reading;
+    if (sliders != robot.sliders)
     {
-      if (blink)
-      {
-        for (uint8_t i = 0; i < NUMBER_LED / 2; i++)
-        {
-          LED_BACK.setPixelColor(i, LED_FRONT.Color(ORANGE_LIGHT[0], ORANGE_LIGHT[1], ORANGE_LIGHT[2]));
-        }
-      }
-      else
-      {
-        for (uint8_t i = 0; i < NUMBER_LED / 2; i++)
-        {
-          LED_BACK.setPixelColor(i, LED_FRONT.Color(0, 0, 0));
-        }
-      }
+      robot.sliders = sliders;
+      robot.speed_max = map(sliders / 2, 1023, 0, speed_min, 255);
     }
-    if (blink_left)
+
+    // Calibrated Stick Deflections (Zero While a Calibration is Measured)
+    robot.calibrating = sticks_update(controller, buttons_state(), millis());
+    robot.forward = stick_deflection(AXIS_Y2, controller.Y2axis_reading);
+    robot.lateral1 = stick_deflection(AXIS_X1, controller.X1axis_reading);
+    robot.lateral2 = stick_deflection(AXIS_X2, controller.X2axis_reading);
+
+    // Blinks Towards the Side the Robot Heads To
+    if (robot.enable_blink)
     {
-      if (blink)
-      {
-        for (uint8_t i = 4; i < NUMBER_LED; i++)
-        {
-          LED_BACK.setPixelColor(i, LED_FRONT.Color(ORANGE_LIGHT[0], ORANGE_LIGHT[1], ORANGE_LIGHT[2]));
-        }
-      }
-      else
-      {
-        for (uint8_t i = 4; i < NUMBER_LED; i++)
-        {
-          LED_BACK.setPixelColor(i, LED_FRONT.Color(0, 0, 0));
-        }
-      }
+      int16_t lateral = (robot.lateral1 != 0) ? robot.lateral1 : robot.lateral2;
+      robot.blink_right = lateral < 0;
+      robot.blink_left = lateral > 0;
     }
+
+#ifdef DEBUG
+    Serial.print(F("Message of "));
+    Serial.print(bytes);
+    Serial.print(F(" bytes received on channel "));
+    Serial.print(packet.pipe);
+    Serial.println(F(" content : "));
+    Serial.print(controller.button1_reading);
+    Serial.print(F(" | "));
+    Serial.print(controller.button2_reading);
+    Serial.print(F(" | "));
+    Serial.print(controller.button3_reading);
+    Serial.print(F(" | "));
+    Serial.print(controller.button4_reading);
+    Serial.print(F(" | "));
+    Serial.print(controller.button5_reading);
+    Serial.print(F(" | "));
+    Serial.println(controller.button6_reading);
+    Serial.print(controller.X1axis_reading);
+    Serial.print(F(" | "));
+    Serial.print(controller.Y1axis_reading);
+    Serial.print(F(" | "));
+    Serial.print(controller.X2axis_reading);
+    Serial.print(F(" | "));
+    Serial.print(controller.Y2axis_reading);
+    Serial.print(F(" | "));
+    Serial.print(controller.slider1_reading);
+    Serial.print(F(" | "));
+    Serial.println(controller.slider2_reading);
+#ifdef RADIO_HOPPING
+    const hop_stats &hopping = hopping_statistics();
+    Serial.print(F("Hop channel "));
+    Serial.print(hopping.channel);
+    Serial.print(F(" mask "));
+    Serial.print(hopping.mask);
+    Serial.print(F(" drops "));
+    Serial.print(hopping.drops);
+    Serial.print(F(" resyncs "));
+    Serial.println(hopping.resyncs);
+#endif
+#ifdef RADIO_ADAPTIVE_RATE
+    const link_stats &link = link_statistics();
+    Serial.print(F("Link profile "));
+    Serial.print(link.profile);
+    Serial.print(F(" ups "));
+    Serial.print(link.step_ups);
+    Serial.print(F(" downs "));
+    Serial.print(link.step_downs);
+    Serial.print(F(" fallbacks "));
+    Serial.println(link.fallbacks);
+#endif
+#endif
   }
-  if (blink_right)
+}
+
+// Control Task: Drives the Motors from the Latest Readings or Stops Them on Failsafe
+void control_task()
+{
+  drive_command drive;
+  drive_command ramped;
+
+  // Checks If Battery Is Charged
+  if (robot.battery_charged)
   {
-    if (blink)
+
+    //******************************************************************************************************************
+    // Handle the Robot Failsafe: Holds the Last Command, Then Slows Down, Then Stops
+    uint8_t tier = failsafe_update(micros());
+    robot.idle = power_update(tier == FAILSAFE_STOP, millis());
+    if (tier == FAILSAFE_STOP)
     {
-      for (uint8_t i = 0; i < NUMBER_LED / 2; i++)
+      if (robot.enable_blink)
       {
-        LED_BACK.setPixelColor(i, LED_FRONT.Color(ORANGE_LIGHT[0], ORANGE_LIGHT[1], ORANGE_LIGHT[2]));
+        robot.blink_right = false;
+        robot.blink_left = false;
       }
+      motors_stop();
+      soc_load(REST_COMMAND);
+      ramp_reset();
+      speed_control_reset();
+      digitalWrite(PIN_BUZZER, HIGH);
+      digitalWrite(LED_BUILTIN, HIGH);
+#ifdef DEBUG
+      Serial.println(F("FAILSAFE!!!"));
+#endif
+      return;
     }
-    else
+
+    // Mixes Forward, Strafe and Turn into the Four Wheels
+    PROFILE_BEGIN(PROFILE_MIXING);
+    if (tier == FAILSAFE_DECEL)
     {
-      for (uint8_t i = 0; i < NUMBER_LED / 2; i++)
-      {
-        LED_BACK.setPixelColor(i, LED_FRONT.Color(0, 0, 0));
-      }
+      drive = REST_COMMAND;
     }
-  }
-  if (blink_left)
-  {
-    if (blink)
+    else if (robot.mode)
     {
-      for (uint8_t i = 4; i < NUMBER_LED; i++)
-      {
-        LED_BACK.setPixelColor(i, LED_FRONT.Color(ORANGE_LIGHT[0], ORANGE_LIGHT[1], ORANGE_LIGHT[2]));
-      }
+      mix_drive<true>(robot.forward, robot.lateral1, robot.lateral2, speed_min, robot.speed_max, drive);
     }
     else
     {
-      for (uint8_t i = 4; i < NUMBER_LED; i++)
-      {
-        LED_BACK.setPixelColor(i, LED_FRONT.Color(0, 0, 0));
-      }
+      mix_drive<false>(robot.forward, robot.lateral1, robot.lateral2, speed_min, robot.speed_max, drive);
     }
+
+    // Limits How Fast Each Wheel Speeds Up, Slows Down and Reverses
+    ramp_update(drive, speed_min << SPEED_TO_DUTY_SHIFT, ramped);
+
+    // Holds Each Wheel at the Speed its Duty Stands For
+    uint8_t edges[NUMBER_WHEELS];
+    encoders_read(edges);
+    speed_control_update(ramped, edges, ramped);
+
+    // Drives the Motors as on the Nominal Battery Whatever the Charge
+    compensation_apply(ramped, ramped);
+    PROFILE_END(PROFILE_MIXING);
+    PROFILE_BEGIN(PROFILE_MOTORS);
+    motors_write(ramped);
+    PROFILE_END(PROFILE_MOTORS);
+
+    // The Duties Sent Stand for the Current Drawn From the Pack
+    soc_load(ramped);
   }
 
-  // Updates LEDs Control
-  LED_FRONT.show();
-  LED_BACK.show();
+  //********************************************************************************************************************
+  // Handle the Robot if Battery is Low
+  else if ((millis() - robot.low_battery_time) > BATTERY_FAILSAFE)
+  {
+    robot.enable_blink = false;
+    robot.front_light = false;
+    robot.back_light = false;
+    motors_stop();
+    soc_load(REST_COMMAND);
+    ramp_reset();
+    speed_control_reset();
+    digitalWrite(LED_BUILTIN, LOW);
+    digitalWrite(PIN_BUZZER, HIGH);
+#ifdef DEBUG
+    Serial.println(F("LOW BATTERY!!!"));
+#endif
+  }
 }
 
-//----------------------------------------------------------------------------------------------------------------------
-//----------------------------------------------------------------------------------------------------------------------
-
-// Functions to Drive the Motors
-void drive_back_left(uint16_t speed, bool dir)
+// Lights Task: Function to Handle the Lights Control (Only Pushes the Strips When the Frame Changes)
+void lights_task()
 {
-  if (dir == 1)
+  PROFILE_BEGIN(PROFILE_LIGHTS);
+  if (robot.idle)
   {
-    digitalWrite(PIN_DIRA, LOW);
+    // Strips Dark While Idle
+    handle_lights(false, false, false, false);
   }
   else
   {
-    digitalWrite(PIN_DIRA, HIGH);
+    handle_lights(robot.front_light, robot.back_light, robot.blink_right || robot.hazard_light,
+                  robot.blink_left || robot.hazard_light);
   }
-  analogWrite(PIN_ENA, speed);
+  PROFILE_END(PROFILE_LIGHTS);
 }
-void drive_front_left(uint16_t speed, bool dir)
+
+// Battery Task: Reads Filtered Battery Voltage
+void battery_task()
 {
-  if (dir == 1)
-  {
-    digitalWrite(PIN_DIRB, LOW);
-  }
-  else
+  PROFILE_BEGIN(PROFILE_BATTERY);
+  battery_sample();
+  robot.bat_reading = battery_reading();
+  compensation_update(robot.bat_reading);
+  soc_update(robot.bat_reading, millis());
+  PROFILE_END(PROFILE_BATTERY);
+#ifdef DEBUG
+  const soc_stats &soc = soc_statistics();
+  Serial.print(F("BATTERY VOLTAGE: "));
+  Serial.print(battery_millivolts(robot.bat_reading));
+  Serial.print(F(" mV, OPEN CIRCUIT: "));
+  Serial.print(soc.open_circuit_mv);
+  Serial.print(F(" mV, SAG AT FULL LOAD: "));
+  Serial.print(soc.resistance_mv);
+  Serial.print(F(" mV, CHARGE: "));
+  Serial.print(soc.percent);
+  Serial.print(F(" %, MINUTES LEFT: "));
+  Serial.println(soc.minutes);
+#endif
+
+  // Updates Battery Timeout While Charged
+  robot.battery_charged = robot.bat_reading > min_bat_reading;
+  if (robot.battery_charged)
   {
-    digitalWrite(PIN_DIRB, HIGH);
+    robot.low_battery_time = millis();
   }
-  analogWrite(PIN_ENB, speed);
 }
-void drive_back_right(uint16_t speed, bool dir)
+
+// Telemetry Task: Reports Back to the Controller (Defined After the Tasks Table it Summarizes)
+void telemetry_task();
+
+#ifdef PROFILE
+// Profile Task: Sends the Stages Statistics
+void profile_task()
+{
+  profiler_report();
+}
+#endif
+
+// Tasks Table (Function, Rate in Hz, Budget in Microseconds)
+scheduler_task TASKS[] = {
+    SCHEDULER_TASK(radio_task, 1000, 400),
+    SCHEDULER_TASK(control_task, CONTROL_RATE, 300),
+    SCHEDULER_TASK(lights_task, 50, 700),
+    SCHEDULER_TASK(battery_task, 10, 100),
+    SCHEDULER_TASK(telemetry_task, 50, 100),
+#ifdef PROFILE
+    SCHEDULER_TASK(profile_task, 1, 2000),
+#endif
+};
+const uint8_t NUMBER_TASKS = sizeof(TASKS) / sizeof(TASKS[0]);
+
+// Telemetry Task: Builds the Frame the Next Acknowledgements Carry
+void telemetry_task()
 {
-  if (dir == 1)
+  telemetry_frame telemetry;
+
+  // Robot State
+  telemetry.flags = 0;
+  const failsafe_stats &failsafe = failsafe_statistics();
+  if (failsafe.tier == FAILSAFE_STOP)
   {
-    digitalWrite(PIN_DIRC, LOW);
+    telemetry.flags |= TELEMETRY_FAILSAFE;
   }
-  else
+  else if (failsafe.tier == FAILSAFE_DECEL)
   {
-    digitalWrite(PIN_DIRC, HIGH);
+    telemetry.flags |= TELEMETRY_DECELERATING;
   }
-  analogWrite(PIN_ENC, speed);
-}
-void drive_front_right(uint16_t speed, bool dir)
-{
-  if (dir == 1)
+  if (!robot.battery_charged)
   {
-    digitalWrite(PIN_DIRD, LOW);
+    telemetry.flags |= TELEMETRY_LOW_BATTERY;
+    if ((millis() - robot.low_battery_time) > BATTERY_FAILSAFE)
+    {
+      telemetry.flags |= TELEMETRY_BATTERY_FAILSAFE;
+    }
   }
-  else
+  if (!robot.mode)
+  {
+    telemetry.flags |= TELEMETRY_MODE_2;
+  }
+  if (robot.calibrating)
   {
-    digitalWrite(PIN_DIRD, HIGH);
+    telemetry.flags |= TELEMETRY_CALIBRATING;
   }
-  analogWrite(PIN_END, speed);
+  telemetry.battery_mv = battery_millivolts(robot.bat_reading);
+
+  // Charge and Driving Time Left, Warning Before the Battery Failsafe
+  const soc_stats &soc = soc_statistics();
+  telemetry.battery_percent = soc.percent;
+  telemetry.battery_minutes = soc.minutes;
+  if (soc.percent <= BATTERY_WARNING_PERCENT || soc.minutes <= BATTERY_WARNING_MINUTES)
+  {
+    telemetry.flags |= TELEMETRY_BATTERY_WARNING;
+  }
+
+  // Worst Task Run Time and Total Budget Overruns
+  telemetry.loop_max_us = 0;
+  telemetry.loop_overruns = 0;
+  for (uint8_t i = 0; i < NUMBER_TASKS; i++)
+  {
+    if (TASKS[i].max_us > telemetry.loop_max_us)
+    {
+      telemetry.loop_max_us = TASKS[i].max_us;
+    }
+    uint32_t overruns = (uint32_t)telemetry.loop_overruns + TASKS[i].overruns;
+    telemetry.loop_overruns = (overruns > 0xFFFF) ? 0xFFFF : overruns;
+  }
+  if (telemetry.loop_overruns > 0)
+  {
+    telemetry.flags |= TELEMETRY_TASK_OVERRUN;
+  }
+
+  // Link Quality (Sequence Gaps Already Include the Overflowed, Malformed and Corrupted Packets)
+  const radio_link_stats &stats = radio_link_statistics();
+  telemetry.packets_received = stats.received;
+  telemetry.packets_dropped = stats.lost + stats.superseded;
+
+  // How the Robot Last Started
+  const boot_stats &boot = boot_statistics();
+  telemetry.reset_reason = boot.reset_reason;
+  telemetry.boot_ms = boot.stage_ms[BOOT_FIRST_PACKET];
+
+  radio_link_set_telemetry(telemetry);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -405,50 +540,57 @@ void drive_front_right(uint16_t speed, bool dir)
 void setup()
 {
 
-#ifdef DEBUG
-  // Serial Initialization
-  Serial.begin(9600);
-#endif
+  // Boot Supervision (Reset Reason, Watchdog and Milestones)
+  boot_begin();
+
+  // L298P Initialization First, Holding the Wheels Stopped From Early On
+  motors_begin();
 
   // Buzzer Pin Initialization
   pinMode(PIN_BUZZER, OUTPUT);
   digitalWrite(PIN_BUZZER, HIGH);
+  boot_mark(BOOT_MOTORS);
 
-  // Battery Input Initialization
-  pinMode(PIN_BAT, INPUT);
-  // Reads Battery Voltage
-  bat_reading = analogRead(PIN_BAT);
-  ADC_voltage = (bat_reading * 5.0) / 1024.0;
-  bat_voltage = ADC_voltage / (R2 / (R1 + R2));
-
-  // Radio Initialization
-  if (!radio.begin())
-  {
-#ifdef DEBUG
-    Serial.println("Radio Initialization Failed!");
+#if defined(DEBUG) || defined(PROFILE) || defined(CAPTURE)
+  // Serial Initialization
+  Serial.begin(9600);
 #endif
-    while (!radio.begin())
-    {
-#ifdef DEBUG
-      Serial.print(F("."));
+#ifdef CAPTURE
+  capture_begin();
 #endif
-    }
-  }
-
-  // Configure Radio for Maximum Power
-  radio.setPALevel(RF24_PA_MAX);
-
-  // Configure Radio Payload Size
-  radio.setPayloadSize(sizeof(controller));
 
-  // Configure Radio Listening Pipe
-  radio.openWritingPipe(address[radio_number]);
+  // Robot State Initialization (Mode 1, Everything Off, Battery Charged Until Measured)
+  memset(&robot, 0, sizeof(robot));
+  robot.mode = true;
+  robot.blink = true;
+  robot.battery_charged = true;
+  robot.speed_max = SPEED_MAX_START;
+  robot.sliders = 0xFFFF;
 
-  // Configure Radio Channel Number
-  radio.openReadingPipe(1, address[!radio_number]);
+  // Stick Calibration (Stored, or Measured at Rest from the First Packets)
+  sticks_begin(STICK_CURVES);
 
-  // Configure Radio to Listen for Incoming Data
-  radio.startListening();
+  // Battery Input Initialization
+  pinMode(PIN_BAT, INPUT);
+  // Starts Background Battery Sampling
+  battery_begin(PIN_BAT);
+  robot.bat_reading = battery_reading();
+  compensation_begin(robot.bat_reading);
+  soc_begin(robot.bat_reading, min_bat_reading);
+
+  // Failsafe Stopped Until the First Packet
+  failsafe_begin();
+
+  // Radio Initialization (A Few Attempts, Then Retried by the Radio Task With the Robot Stopped)
+  robot.radio_ready = boot_radio(RADIO_BEGIN_ATTEMPTS);
+  robot.radio_listening = robot.radio_ready;
+  robot.radio_retry_time = millis();
+#ifdef DEBUG
+  if (!robot.radio_ready)
+  {
+    Serial.println(F("Radio Initialization Failed!"));
+  }
+#endif
 
   // Front LED Module Initialization
   LED_FRONT.begin();
@@ -460,29 +602,27 @@ void setup()
   LED_BACK.clear();
   LED_BACK.show();
 
-  // L298P Configuration
-  pinMode(PIN_DIRA, OUTPUT);
-  pinMode(PIN_ENA, OUTPUT);
-  pinMode(PIN_DIRB, OUTPUT);
-  pinMode(PIN_ENB, OUTPUT);
-  pinMode(PIN_DIRC, OUTPUT);
-  pinMode(PIN_ENC, OUTPUT);
-  pinMode(PIN_DIRD, OUTPUT);
-  pinMode(PIN_END, OUTPUT);
-
-  // L298P Initialization
-  digitalWrite(PIN_DIRA, LOW);
-  analogWrite(PIN_ENA, 0);
-  digitalWrite(PIN_DIRB, LOW);
-  analogWrite(PIN_ENB, 0);
-  digitalWrite(PIN_DIRC, LOW);
-  analogWrite(PIN_ENC, 0);
-  digitalWrite(PIN_DIRD, LOW);
-  analogWrite(PIN_END, 0);
+  // Lights Renderer Initialization
+  lights_begin(&LED_FRONT, &LED_BACK);
+
+  // Wheel Ramps Stepped at the Control Rate
+  for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+  {
+    ramp_configure(i, DRIVE_RAMP, 1000000UL / CONTROL_RATE);
+  }
+
+  // Wheel Encoders and Speed Controllers Stepped at the Control Rate
+  speed_control_begin(encoders_begin(), 1000000UL / CONTROL_RATE);
+  speed_control_configure(WHEEL_GAINS);
 
   // LED BUILTIN Configuration
   pinMode(LED_BUILTIN, OUTPUT);
   digitalWrite(LED_BUILTIN, LOW);
+  boot_mark(BOOT_READY);
+
+  // Sleep Wakes Between Tasks and Tasks Scheduler Initialization
+  power_begin();
+  scheduler_begin(TASKS, NUMBER_TASKS);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -491,555 +631,11 @@ void setup()
 // Code Loop Function
 void loop()
 {
+  boot_watchdog_pet();
 
-  // Reads Battery Voltage
-  bat_reading = analogRead(PIN_BAT);
-  ADC_voltage = (bat_reading * 5.0) / 1024.0;
-  bat_voltage = ADC_voltage / (R2 / (R1 + R2));
-#ifdef DEBUG
-  Serial.print("BATTERY VOLTAGE: ");
-  Serial.print(bat_voltage);
-  Serial.println(" V");
-#endif
-
-  // Checks If Battery Is Charged
-  if (bat_voltage > min_bat_voltage)
-  {
-
-    // Updates Battery Timeout
-    low_battery_time = millis();
-
-    // Checks If New Reading Available
-    if (radio.available(&channel))
-    {
-      // Reads Messages From Controller
-      bytes = radio.getPayloadSize();
-      radio.read(&controller, bytes);
-
-      // Updates Lest Message Time
-      last_message = millis();
-      digitalWrite(LED_BUILTIN, HIGH);
-
-      //********************************************************************************************************************
-      // Mode Control Changer
-      reading_button1 = controller.button1_reading;
-      if (reading_button1 != last_button1_state)
-      {
-        last_debounce_time1 = millis();
-      }
-      if ((millis() - last_debounce_time1) > DEBOUNCE_TIME)
-      {
-        if (reading_button1 != button1_state)
-        {
-          button1_state = reading_button1;
-          if (button1_state == 1)
-          {
-            mode = false;
-          }
-          else
-          {
-            mode = true;
-          }
-        }
-      }
-      last_button1_state = reading_button1;
-
-      //********************************************************************************************************************
-      // Light Blink Enabling Changer
-      reading_button2 = controller.button2_reading;
-      if (reading_button2 != last_button2_state)
-      {
-        last_debounce_time2 = millis();
-      }
-      if ((millis() - last_debounce_time2) > DEBOUNCE_TIME)
-      {
-        if (reading_button2 != button2_state)
-        {
-          button2_state = reading_button2;
-          if (button2_state == 1)
-          {
-            enable_blink = true;
-          }
-          else
-          {
-            enable_blink = false;
-          }
-        }
-      }
-      last_button2_state = reading_button2;
-
-      //********************************************************************************************************************
-      // Control the Front Light
-      reading_button3 = controller.button3_reading;
-      if (reading_button3 != last_button3_state)
-      {
-        last_debounce_time3 = millis();
-      }
-      if ((millis() - last_debounce_time3) > DEBOUNCE_TIME)
-      {
-        if (reading_button3 != button3_state)
-        {
-          button3_state = reading_button3;
-          if (button3_state == 1)
-          {
-            back_light = true;
-          }
-          else
-          {
-            back_light = false;
-          }
-        }
-      }
-      last_button3_state = reading_button3;
-
-      //********************************************************************************************************************
-      // Control the Back Light
-      reading_button4 = controller.button4_reading;
-      if (reading_button4 != last_button4_state)
-      {
-        last_debounce_time4 = millis();
-      }
-      if ((millis() - last_debounce_time4) > DEBOUNCE_TIME)
-      {
-        if (reading_button4 != button4_state)
-        {
-          button4_state = reading_button4;
-          if (button4_state == 1)
-          {
-            front_light = true;
-          }
-          else
-          {
-            front_light = false;
-          }
-        }
-      }
-      last_button4_state = reading_button4;
-
-      //********************************************************************************************************************
-      // Control the Buzzer
-      reading_button5 = controller.button5_reading;
-      if (reading_button5 != last_button5_state)
-      {
-        last_debounce_time5 = millis();
-      }
-      if ((millis() - last_debounce_time5) > DEBOUNCE_TIME)
-      {
-        if (reading_button5 != button5_state)
-        {
-          button5_state = reading_button5;
-          if (button5_state == 1)
-          {
-            digitalWrite(PIN_BUZZER, LOW);
-          }
-          else
-          {
-            digitalWrite(PIN_BUZZER, HIGH);
-          }
-        }
-      }
-      last_button5_state = reading_button5;
-
-      //********************************************************************************************************************
-      /*
-      reading_button6 = controller.button6_reading;
-      if (reading_button6 != last_button6_state)
-      {
-        last_debounce_time6 = millis();
-      }
-      if ((millis() - last_debounce_time6) > DEBOUNCE_TIME)
-      {
-        if (reading_button6 != button6_state)
-        {
-          button6_state = reading_button6;
-          if (button6_state == 1)
-          {
-          }
-          else
-          {
-          }
-        }
-      }
-      last_button6_state = reading_button6;
-      */
-
-      //********************************************************************************************************************
-      // Speed Max Adjustment
-      speed_max = map(((controller.slider1_reading + controller.slider2_reading) / 2), 1023, 0, speed_min, 255);
-
-      // Handle the Robot Control when the Joysticks Heads Forward
-      if (controller.Y2axis_reading > 550)
-      {
-        vertical = map(controller.Y2axis_reading, 550, 1023, speed_min, speed_max);
-        if (controller.X1axis_reading > 550)
-        {
-          horizontal = map(controller.X1axis_reading, 550, 1023, speed_max, speed_max / 4);
-          difference = abs(vertical - horizontal);
-          sum = vertical + difference;
-          sub = vertical - difference;
-          if (enable_blink)
-          {
-            blink_right = false;
-            blink_left = true;
-          }
-          if (mode)
-          {
-            drive_front_left(sub, 1);
-            drive_front_right(sum, 1);
-            drive_back_left(sub, 1);
-            drive_back_right(sum, 1);
-          }
-          else
-          {
-            drive_front_left(sub, 1);
-            drive_front_right(sum, 1);
-            drive_back_left(sum, 1);
-            drive_back_right(sub, 1);
-          }
-        }
-        else if (controller.X1axis_reading < 500)
-        {
-          horizontal = map(controller.X1axis_reading, 500, 0, speed_max, speed_max / 4);
-          difference = abs(vertical - horizontal);
-          sum = vertical + difference;
-          sub = vertical - difference;
-          if (enable_blink)
-          {
-            blink_right = true;
-            blink_left = false;
-          }
-          if (mode)
-          {
-            drive_front_left(sum, 1);
-            drive_front_right(sub, 1);
-            drive_back_left(sum, 1);
-            drive_back_right(sub, 1);
-          }
-          else
-          {
-            drive_front_left(sum, 1);
-            drive_front_right(sub, 1);
-            drive_back_left(sub, 1);
-            drive_back_right(sum, 1);
-          }
-        }
-        else
-        {
-          if (enable_blink)
-          {
-            blink_right = false;
-            blink_left = false;
-          }
-          drive_front_left(vertical, 1);
-          drive_front_right(vertical, 1);
-          drive_back_left(vertical, 1);
-          drive_back_right(vertical, 1);
-        }
-      }
-
-      //********************************************************************************************************************
-      // Handle the Robot Control when the Joysticks Heads Backward
-      else if (controller.Y2axis_reading < 500)
-      {
-        vertical = map(controller.Y2axis_reading, 500, 0, speed_min, speed_max);
-        if (controller.X1axis_reading > 550)
-        {
-          horizontal = map(controller.X1axis_reading, 550, 1023, speed_max, speed_max / 4);
-          difference = abs(vertical - horizontal);
-          sum = vertical + difference;
-          sub = vertical - difference;
-          if (enable_blink)
-          {
-            blink_right = false;
-            blink_left = true;
-          }
-          if (mode)
-          {
-            drive_front_left(sub, 0);
-            drive_front_right(sum, 0);
-            drive_back_left(sub, 0);
-            drive_back_right(sum, 0);
-          }
-          else
-          {
-            drive_front_left(sum, 0);
-            drive_front_right(sub, 0);
-            drive_back_left(sub, 0);
-            drive_back_right(sum, 0);
-          }
-        }
-        else if (controller.X1axis_reading < 500)
-        {
-          horizontal = map(controller.X1axis_reading, 500, 0, speed_max, speed_max / 4);
-          difference = abs(vertical - horizontal);
-          sum = vertical + difference;
-          sub = vertical - difference;
-          if (enable_blink)
-          {
-            blink_right = true;
-            blink_left = false;
-          }
-          if (mode)
-          {
-            drive_front_left(sum, 0);
-            drive_front_right(sub, 0);
-            drive_back_left(sum, 0);
-            drive_back_right(sub, 0);
-          }
-          else
-          {
-            drive_front_left(sub, 0);
-            drive_front_right(sum, 0);
-            drive_back_left(sum, 0);
-            drive_back_right(sub, 0);
-          }
-        }
-        else
-        {
-          if (enable_blink)
-          {
-            blink_right = false;
-            blink_left = false;
-          }
-          drive_front_left(vertical, 0);
-          drive_front_right(vertical, 0);
-          drive_back_left(vertical, 0);
-          drive_back_right(vertical, 0);
-        }
-      }
-
-      //********************************************************************************************************************
-      // Handle the Robot Control when the Joysticks Heads Left
-      else if (controller.X1axis_reading > 550)
-      {
-        horizontal = map(controller.X1axis_reading, 550, 1023, speed_min, speed_max);
-        if (enable_blink)
-        {
-          blink_right = false;
-          blink_left = true;
-        }
-        if (mode)
-        {
-          drive_front_left(horizontal, 0);
-          drive_front_right(horizontal, 1);
-          drive_back_left(horizontal, 0);
-          drive_back_right(horizontal, 1);
-        }
-        else
-        {
-          drive_front_left(horizontal, 0);
-          drive_front_right(horizontal, 1);
-          drive_back_left(horizontal, 1);
-          drive_back_right(horizontal, 0);
-        }
-      }
-
-      //********************************************************************************************************************
-      // Handle the Robot Control when the Joysticks Heads Left
-      else if (controller.X1axis_reading < 500)
-      {
-        horizontal = map(controller.X1axis_reading, 500, 0, speed_min, speed_max);
-        if (enable_blink)
-        {
-          blink_right = true;
-          blink_left = false;
-        }
-        if (mode)
-        {
-          drive_front_left(horizontal, 1);
-          drive_front_right(horizontal, 0);
-          drive_back_left(horizontal, 1);
-          drive_back_right(horizontal, 0);
-        }
-        else
-        {
-          drive_front_left(horizontal, 1);
-          drive_front_right(horizontal, 0);
-          drive_back_left(horizontal, 0);
-          drive_back_right(horizontal, 1);
-        }
-      }
-
-      //********************************************************************************************************************
-      // Checks if Joystick is Heading Forward
-      else if (controller.Y1axis_reading > 550 && mode)
-      {
-        vertical = map(controller.Y1axis_reading, 550, 1023, speed_min, speed_max);
-        if (controller.X2axis_reading > 550)
-        {
-          horizontal = map(controller.X2axis_reading, 550, 1023, speed_min, speed_max);
-          if (enable_blink)
-          {
-            blink_right = false;
-            blink_left = true;
-          }
-          drive_front_left(stop_speed, 0);
-          drive_front_right(stop_speed, 0);
-          drive_back_left(horizontal, 1);
-          drive_back_right(horizontal, 0);
-        }
-        else if (controller.X2axis_reading < 500)
-        {
-          horizontal = map(controller.X2axis_reading, 500, 0, speed_min, speed_max);
-          if (enable_blink)
-          {
-            blink_right = true;
-            blink_left = false;
-          }
-          drive_front_left(stop_speed, 0);
-          drive_front_right(stop_speed, 0);
-          drive_back_left(horizontal, 0);
-          drive_back_right(horizontal, 1);
-        }
-        else
-        {
-          if (enable_blink)
-          {
-            blink_right = false;
-            blink_left = false;
-          }
-          drive_front_left(stop_speed, 0);
-          drive_front_right(stop_speed, 0);
-          drive_back_left(vertical, 1);
-          drive_back_right(vertical, 1);
-        }
-      }
-
-      //********************************************************************************************************************
-      // Checks if Joystick is Heading Backward
-      else if (controller.Y1axis_reading < 500 && mode)
-      {
-        vertical = map(controller.Y1axis_reading, 500, 0, speed_min, speed_max);
-        if (controller.X2axis_reading > 550)
-        {
-          horizontal = map(controller.X2axis_reading, 550, 1023, speed_min, speed_max);
-          if (enable_blink)
-          {
-            blink_right = false;
-            blink_left = true;
-          }
-          drive_front_left(horizontal, 0);
-          drive_front_right(horizontal, 1);
-          drive_back_left(stop_speed, 0);
-          drive_back_right(stop_speed, 0);
-        }
-        else if (controller.X2axis_reading < 500)
-        {
-          horizontal = map(controller.X2axis_reading, 500, 0, speed_min, speed_max);
-          if (enable_blink)
-          {
-            blink_right = true;
-            blink_left = false;
-          }
-          drive_front_left(horizontal, 1);
-          drive_front_right(horizontal, 0);
-          drive_back_left(stop_speed, 0);
-          drive_back_right(stop_speed, 0);
-        }
-        else
-        {
-          if (enable_blink)
-          {
-            blink_right = false;
-            blink_left = false;
-          }
-          drive_front_left(vertical, 0);
-          drive_front_right(vertical, 0);
-          drive_back_left(stop_speed, 0);
-          drive_back_right(stop_speed, 0);
-        }
-      }
-
-      //********************************************************************************************************************
-      // Stops the Robot if Joystick is Centered
-      else
-      {
-        if (enable_blink)
-        {
-          blink_right = false;
-          blink_left = false;
-        }
-        drive_front_left(stop_speed, 0);
-        drive_front_right(stop_speed, 0);
-        drive_back_left(stop_speed, 0);
-        drive_back_right(stop_speed, 0);
-      }
-
-      // Function to Handle the Lights Control
-      handle_lights(front_light, back_light, blink_right, blink_left);
-
-#ifdef DEBUG
-      Serial.print("Message of ");
-      Serial.print(bytes);
-      Serial.print(" bytes received on channel ");
-      Serial.print(channel);
-      Serial.println(" content : ");
-      Serial.print(controller.button1_reading);
-      Serial.print(" | ");
-      Serial.print(controller.button2_reading);
-      Serial.print(" | ");
-      Serial.print(controller.button3_reading);
-      Serial.print(" | ");
-      Serial.print(controller.button4_reading);
-      Serial.print(" | ");
-      Serial.print(controller.button5_reading);
-      Serial.print(" | ");
-      Serial.println(controller.button6_reading);
-      Serial.print(controller.X1axis_reading);
-      Serial.print(" | ");
-      Serial.print(controller.Y1axis_reading);
-      Serial.print(" | ");
-      Serial.print(controller.X2axis_reading);
-      Serial.print(" | ");
-      Serial.print(controller.Y2axis_reading);
-      Serial.print(" | ");
-      Serial.print(controller.slider1_reading);
-      Serial.print(" | ");
-      Serial.println(controller.slider2_reading);
-#endif
-    }
-
-    //********************************************************************************************************************
-    // Handle the Robot Failsafe
-    else if ((millis() - last_message) > FAILSAFE_INTERVAL)
-    {
-      if (enable_blink)
-      {
-        blink_right = false;
-        blink_left = false;
-      }
-      handle_lights(front_light, back_light, blink_right, blink_left);
-      drive_front_left(stop_speed, 0);
-      drive_front_right(stop_speed, 0);
-      drive_back_left(stop_speed, 0);
-      drive_back_right(stop_speed, 0);
-      digitalWrite(PIN_BUZZER, HIGH);
-      digitalWrite(LED_BUILTIN, HIGH);
-#ifdef DEBUG
-      Serial.println("FAILSAFE!!!");
-#endif
-    }
-  }
-
-  //********************************************************************************************************************
-  // Handle the Robot if Battery is Low
-  else if ((millis() - low_battery_time) > BATTERY_FAILSAFE)
-  {
-    enable_blink = false;
-    front_light = false;
-    back_light = false;
-    handle_lights(front_light, back_light, blink_right, blink_left);
-    drive_front_left(stop_speed, 0);
-    drive_front_right(stop_speed, 0);
-    drive_back_left(stop_speed, 0);
-    drive_back_right(stop_speed, 0);
-    digitalWrite(LED_BUILTIN, LOW);
-    digitalWrite(PIN_BUZZER, HIGH);
-#ifdef DEBUG
-    Serial.println("LOW BATTERY!!!");
-#endif
-  }
+  // Sleeps Until the Next Task is Due or an Interrupt Comes
+  power_sleep(scheduler_run(TASKS, NUMBER_TASKS));
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-//----------------------------------------------------------------------------------------------------------------------
\ No newline at end of file
+//----------------------------------------------------------------------------------------------------------------------
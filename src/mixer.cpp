@@ -0,0 +1,57 @@
+// Mecanum Wheels Mixer
+#include "mixer.h"
+
+// Function to Mix the Robot Motion into the Wheels Duties
+template <bool MODE>
+void mix_drive(int16_t forward, int16_t x1, int16_t x2, uint8_t speed_min, uint8_t speed_max, drive_command &command)
+{
+  // Selects the Stick Roles of the Control Mode
+  const int16_t strafe = MODE ? x2 : x1;
+  const int16_t turn = MODE ? x1 : x2;
+
+  // Inverse Kinematics
+  int16_t wheel[NUMBER_WHEELS];
+  wheel[WHEEL_FRONT_LEFT] = forward - strafe - turn;
+  wheel[WHEEL_FRONT_RIGHT] = forward + strafe + turn;
+  wheel[WHEEL_BACK_LEFT] = forward + strafe - turn;
+  wheel[WHEEL_BACK_RIGHT] = forward - strafe + turn;
+
+  // Finds the Fastest Wheel
+  int16_t peak = 0;
+  for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+  {
+    int16_t magnitude = (wheel[i] < 0) ? -wheel[i] : wheel[i];
+    if (magnitude > peak)
+    {
+      peak = magnitude;
+    }
+  }
+
+  // Scales All Wheels Down Together When One Saturates, Keeping the Motion Direction
+  uint16_t scale = DEFLECTION_FULL_SCALE;
+  if (peak > DEFLECTION_FULL_SCALE)
+  {
+    // Full Scale Squared (65536) Needs 32 Bits, int is Only 16 on the AVR
+    scale = (uint16_t)(((uint32_t)DEFLECTION_FULL_SCALE * DEFLECTION_FULL_SCALE) / peak);
+  }
+
+  // Maps Each Wheel Between the Minimum and Maximum Speeds
+  const uint16_t span = (speed_max > speed_min) ? (speed_max - speed_min) : 0;
+  const uint16_t offset = (uint16_t)speed_min << SPEED_TO_DUTY_SHIFT;
+  for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+  {
+    if (wheel[i] == 0)
+    {
+      command.duty[i] = 0;
+      continue;
+    }
+    uint16_t magnitude = (wheel[i] < 0) ? -wheel[i] : wheel[i];
+    magnitude = ((uint32_t)magnitude * scale) >> 8;
+    uint16_t duty = offset + ((magnitude * span) >> (8 - SPEED_TO_DUTY_SHIFT));
+    command.duty[i] = (wheel[i] < 0) ? -(int16_t)duty : (int16_t)duty;
+  }
+}
+
+// Control Modes Instances
+template void mix_drive<true>(int16_t, int16_t, int16_t, uint8_t, uint8_t, drive_command &);
+template void mix_drive<false>(int16_t, int16_t, int16_t, uint8_t, uint8_t, drive_command &);
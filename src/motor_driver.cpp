@@ -0,0 +1,108 @@
+// L298P Motor Shield Driver
+#include <Arduino.h>
+#include "motor_driver.h"
+
+#if defined(__AVR_ATmega32U4__)
+#include <util/atomic.h>
+#define MOTORS_ATOMIC() ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+#else
+#define MOTORS_ATOMIC()
+#endif
+
+// Last Values Written to Each Wheel
+static uint16_t written_speed[NUMBER_WHEELS];
+static bool written_direction[NUMBER_WHEELS];
+
+// Stop Command
+static const drive_command STOP_COMMAND = {{0, 0, 0, 0}};
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Write One Wheel if its Command Changed
+template <typename CHANNEL>
+static inline void write_wheel(uint8_t wheel, uint16_t speed, bool dir)
+{
+  if (dir != written_direction[wheel])
+  {
+    CHANNEL::direction(dir);
+    written_direction[wheel] = dir;
+  }
+  if (speed != written_speed[wheel])
+  {
+    CHANNEL::speed(speed);
+    written_speed[wheel] = speed;
+  }
+}
+
+// Function to Run Timers 1, 3 and 4 in Fast PWM at the Same Frequency and Resolution
+static void pwm_begin(void)
+{
+#if defined(__AVR_ATmega32U4__)
+  MOTORS_ATOMIC()
+  {
+    // Timer1 and Timer3: Mode 14 (Fast PWM, TOP = ICRn), No Prescaler, Outputs Disconnected
+    TCCR1A = (1 << WGM11);
+    TCCR1B = (1 << WGM13) | (1 << WGM12) | (1 << CS10);
+    ICR1 = PWM_TOP;
+    TCCR3A = (1 << WGM31);
+    TCCR3B = (1 << WGM33) | (1 << WGM32) | (1 << CS30);
+    ICR3 = PWM_TOP;
+
+    // Timer4: Fast PWM on OC4D (TOP = OCR4C, 10-bit Through TC4H), No Prescaler
+    TCCR4B = 0;
+    TCCR4C = (TCCR4C & ~((1 << COM4D1) | (1 << COM4D0))) | (1 << PWM4D);
+    TCCR4D = 0;
+    TC4H = PWM_TOP >> 8;
+    OCR4C = PWM_TOP & 0xFF;
+    TC4H = 0;
+    TCNT4 = 0;
+    TCCR4B = (1 << CS40);
+  }
+#endif
+}
+
+// Function to Initialize the L298P
+void motors_begin(void)
+{
+  pwm_begin();
+  motor_front_left::begin();
+  motor_front_right::begin();
+  motor_back_left::begin();
+  motor_back_right::begin();
+
+  // Pins Start Low (Forward) and Stopped
+  for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+  {
+    written_speed[i] = 0;
+    written_direction[i] = true;
+  }
+}
+
+// Function to Drive the Motors
+void motors_write(const drive_command &command)
+{
+  // Converts Everything Before Touching the Pins
+  uint16_t speed[NUMBER_WHEELS];
+  bool dir[NUMBER_WHEELS];
+  for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+  {
+    speed[i] = duty_to_pwm(command.duty[i]);
+    dir[i] = duty_to_direction(command.duty[i]);
+  }
+
+  // Updates the Four Wheels Together
+  MOTORS_ATOMIC()
+  {
+    write_wheel<motor_front_left>(WHEEL_FRONT_LEFT, speed[WHEEL_FRONT_LEFT], dir[WHEEL_FRONT_LEFT]);
+    write_wheel<motor_front_right>(WHEEL_FRONT_RIGHT, speed[WHEEL_FRONT_RIGHT], dir[WHEEL_FRONT_RIGHT]);
+    write_wheel<motor_back_left>(WHEEL_BACK_LEFT, speed[WHEEL_BACK_LEFT], dir[WHEEL_BACK_LEFT]);
+    write_wheel<motor_back_right>(WHEEL_BACK_RIGHT, speed[WHEEL_BACK_RIGHT], dir[WHEEL_BACK_RIGHT]);
+  }
+}
+
+// Function to Stop the Motors
+void motors_stop(void)
+{
+  motors_write(STOP_COMMAND);
+}
@@ -0,0 +1,118 @@
+// Low Power Idle
+#include <Arduino.h>
+#include "power.h"
+
+#if defined(__AVR_ATmega32U4__)
+#include <avr/sleep.h>
+#endif
+
+// Idle State
+static bool stopped_before = false;
+static bool idle = false;
+static unsigned long stopped_since = 0;
+static unsigned long window_start = 0;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Follow the Failsafe
+bool power_update(bool stopped, unsigned long now)
+{
+  if (!stopped)
+  {
+    stopped_before = false;
+    idle = false;
+    return false;
+  }
+
+  if (!stopped_before)
+  {
+    stopped_before = true;
+    stopped_since = now;
+  }
+  if (!idle && (now - stopped_since) >= POWER_IDLE_DELAY_MS)
+  {
+    // Idle Period Starts With a Listening Window
+    idle = true;
+    window_start = now;
+  }
+  return idle;
+}
+
+// Function to Tell Whether the Radio Should Listen
+bool power_radio_window(unsigned long now)
+{
+  if (!idle)
+  {
+    return true;
+  }
+  while ((now - window_start) >= POWER_LISTEN_PERIOD_MS)
+  {
+    window_start += POWER_LISTEN_PERIOD_MS;
+  }
+  return (now - window_start) < POWER_LISTEN_MS;
+}
+
+#if defined(__AVR_ATmega32U4__)
+
+// Timer0 Tick (the millis() Prescaler of 64)
+static const uint8_t TIMER0_TICK_US = 64 / (F_CPU / 1000000UL);
+
+// Timer0 Counts of the Compare Wakes, Splitting the Overflow Period in Thirds
+static const uint8_t WAKE_COUNT_A = 85;
+static const uint8_t WAKE_COUNT_B = 170;
+
+// Timer0 Compare Matches Only End a Sleep
+EMPTY_INTERRUPT(TIMER0_COMPA_vect);
+EMPTY_INTERRUPT(TIMER0_COMPB_vect);
+
+// Function to Set the Sleep Wakes
+void power_begin(void)
+{
+  // Fast PWM Mode of the Arduino Core Loads These at the Next Overflow, They Never Change Afterwards
+  OCR0A = WAKE_COUNT_A;
+  OCR0B = WAKE_COUNT_B;
+}
+
+// Function to Sleep Until the Next Wake Point, Unless the Release Comes First
+void power_sleep(uint32_t idle_us)
+{
+  if (idle_us < POWER_SLEEP_MIN_US)
+  {
+    return;
+  }
+
+  // Interrupts Stay Off Until the Sleep Instruction, So None Can Slip In Between and Leave the MCU Asleep. Flags
+  // Cleared Before TCNT0 is Read, a Match Right After Still Wakes the MCU at Once
+  cli();
+  TIFR0 = (1 << OCF0A) | (1 << OCF0B);
+  uint8_t count = TCNT0;
+  uint16_t wake = (count < WAKE_COUNT_A) ? WAKE_COUNT_A : (count < WAKE_COUNT_B) ? WAKE_COUNT_B : 256;
+  if ((uint32_t)(wake - count) * TIMER0_TICK_US > idle_us)
+  {
+    // Would Wake After the Release, the Gap is Polled Instead
+    sei();
+    return;
+  }
+  TIMSK0 |= (1 << OCIE0A) | (1 << OCIE0B);
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  sleep_enable();
+  sei();
+  sleep_cpu();
+  sleep_disable();
+  TIMSK0 &= ~((1 << OCIE0A) | (1 << OCIE0B));
+}
+
+#else
+
+// Function to Set the Sleep Wakes
+void power_begin(void)
+{
+}
+
+// Function to Sleep (Host Builds Run on the Harness Clock, Nothing to Wait For)
+void power_sleep(uint32_t)
+{
+}
+
+#endif
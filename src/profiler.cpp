@@ -0,0 +1,124 @@
+// Loop Stages Profiler
+#include <Arduino.h>
+#include "profiler.h"
+
+#if !defined(__AVR__)
+#include <time.h>
+#endif
+
+// Stage Statistics
+typedef struct
+{
+  uint16_t count;
+  uint16_t min;
+  uint16_t max;
+  uint32_t total;
+  uint16_t histogram[PROFILE_BUCKETS];
+} stage_stats;
+static stage_stats stages[NUMBER_PROFILE_STAGES];
+
+// Profiler Clock Tick Length
+#if defined(__AVR__)
+static const uint16_t TICK_NS = 64000000UL / (F_CPU / 1000UL);
+extern volatile unsigned long timer0_overflow_count;
+#else
+static const uint16_t TICK_NS = 1;
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Read the Profiler Clock
+uint16_t profiler_ticks(void)
+{
+#if defined(__AVR__)
+  // Timer0 Counter Extended by the Low Byte of the millis() Overflow Count
+  uint8_t sreg = SREG;
+  cli();
+  uint8_t low = TCNT0;
+  uint8_t high = (uint8_t)timer0_overflow_count;
+  if ((TIFR0 & (1 << TOV0)) && (low < 255))
+  {
+    high++;
+  }
+  SREG = sreg;
+  return ((uint16_t)high << 8) | low;
+#else
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint16_t)now.tv_nsec;
+#endif
+}
+
+// Function to Record One Stage Duration
+void profiler_record(uint8_t stage, uint16_t ticks)
+{
+  stage_stats &stats = stages[stage];
+  if (stats.count == 0 || ticks < stats.min)
+  {
+    stats.min = ticks;
+  }
+  if (ticks > stats.max)
+  {
+    stats.max = ticks;
+  }
+  stats.total += ticks;
+  stats.count++;
+
+  // Log2 Bucket
+  uint8_t bucket = 0;
+  while (ticks != 0 && bucket < PROFILE_BUCKETS - 1)
+  {
+    ticks >>= 1;
+    bucket++;
+  }
+  stats.histogram[bucket]++;
+}
+
+// Report Frame Size
+static const uint16_t FRAME_SIZE = 6 + NUMBER_PROFILE_STAGES * (10 + 2 * PROFILE_BUCKETS) + 1;
+
+// Function to Append a Little Endian Word to the Frame
+static uint8_t *put_word(uint8_t *out, uint16_t value)
+{
+  *out++ = value & 0xFF;
+  *out++ = value >> 8;
+  return out;
+}
+
+// Function to Send the Statistics Frame
+void profiler_report(void)
+{
+  uint8_t frame[FRAME_SIZE];
+  uint8_t *out = frame;
+  *out++ = 0xA5;
+  *out++ = 0x5A;
+  *out++ = PROFILE_FRAME_VERSION;
+  *out++ = NUMBER_PROFILE_STAGES;
+  out = put_word(out, TICK_NS);
+  for (uint8_t s = 0; s < NUMBER_PROFILE_STAGES; s++)
+  {
+    const stage_stats &stats = stages[s];
+    out = put_word(out, stats.count);
+    out = put_word(out, stats.min);
+    out = put_word(out, stats.max);
+    out = put_word(out, stats.total & 0xFFFF);
+    out = put_word(out, stats.total >> 16);
+    for (uint8_t b = 0; b < PROFILE_BUCKETS; b++)
+    {
+      out = put_word(out, stats.histogram[b]);
+    }
+  }
+
+  // Checksum Makes the Byte Sum of the Whole Frame Zero
+  uint8_t sum = 0;
+  for (uint8_t *byte = frame; byte < out; byte++)
+  {
+    sum += *byte;
+  }
+  *out = -sum;
+  Serial.write(frame, FRAME_SIZE);
+
+  // Starts a New Measuring Window
+  memset(stages, 0, sizeof(stages));
+}
@@ -0,0 +1,104 @@
+// Controller Packet Wire Format
+#include <Arduino.h>
+#include "radio_frame.h"
+
+// CRC-8 Remainders of Each Nibble (Two Lookups per Byte Keep the Table at 16 Bytes)
+static const uint8_t CRC_NIBBLES[16] PROGMEM = {
+    0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15, 0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D};
+
+// Maximum Analog Reading
+static const uint16_t ANALOG_MAX = (1 << RADIO_FRAME_ANALOG_BITS) - 1;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Read One 10-bit Field
+static inline uint16_t unpack_analog(const uint8_t *analog, uint8_t field)
+{
+  const uint8_t bit = field * RADIO_FRAME_ANALOG_BITS;
+  const uint8_t *bytes = &analog[bit >> 3];
+  const uint8_t shift = bit & 7;
+  return ((bytes[0] >> shift) | ((uint16_t)bytes[1] << (8 - shift))) & ANALOG_MAX;
+}
+
+// Function to Write One 10-bit Field (Fields Must Be Written in Order Over a Zeroed Array)
+static inline void pack_analog(uint8_t *analog, uint8_t field, uint16_t value)
+{
+  const uint8_t bit = field * RADIO_FRAME_ANALOG_BITS;
+  uint8_t *bytes = &analog[bit >> 3];
+  const uint8_t shift = bit & 7;
+  value = (value > ANALOG_MAX) ? ANALOG_MAX : value;
+  bytes[0] |= (uint8_t)(value << shift);
+  bytes[1] |= (uint8_t)(value >> (8 - shift));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Compute the CRC-8 of a Buffer
+uint8_t radio_frame_crc(const uint8_t *data, uint8_t length)
+{
+  uint8_t crc = 0xFF;
+  for (uint8_t i = 0; i < length; i++)
+  {
+    crc ^= data[i];
+    crc = (crc << 4) ^ pgm_read_byte(&CRC_NIBBLES[crc >> 4]);
+    crc = (crc << 4) ^ pgm_read_byte(&CRC_NIBBLES[crc >> 4]);
+  }
+  return crc;
+}
+
+// Function to Build a Frame
+void radio_frame_encode(const controller_variables &controller, uint8_t sequence, radio_frame &frame, uint8_t retries)
+{
+  frame.version = RADIO_FRAME_VERSION;
+  frame.sequence = sequence;
+
+  // Buttons Bitfield
+  frame.buttons = 0;
+  frame.buttons |= controller.button1_reading ? 0x01 : 0;
+  frame.buttons |= controller.button2_reading ? 0x02 : 0;
+  frame.buttons |= controller.button3_reading ? 0x04 : 0;
+  frame.buttons |= controller.button4_reading ? 0x08 : 0;
+  frame.buttons |= controller.button5_reading ? 0x10 : 0;
+  frame.buttons |= controller.button6_reading ? 0x20 : 0;
+  retries = (retries > RADIO_FRAME_RETRIES_MAX) ? RADIO_FRAME_RETRIES_MAX : retries;
+  frame.buttons |= retries << RADIO_FRAME_RETRIES_SHIFT;
+
+  // Analog Fields
+  memset(frame.analog, 0, sizeof(frame.analog));
+  pack_analog(frame.analog, 0, controller.X1axis_reading);
+  pack_analog(frame.analog, 1, controller.Y1axis_reading);
+  pack_analog(frame.analog, 2, controller.X2axis_reading);
+  pack_analog(frame.analog, 3, controller.Y2axis_reading);
+  pack_analog(frame.analog, 4, controller.slider1_reading);
+  pack_analog(frame.analog, 5, controller.slider2_reading);
+
+  frame.crc = radio_frame_crc((const uint8_t *)&frame, sizeof(frame) - 1);
+}
+
+// Function to Check a Frame
+bool radio_frame_valid(const radio_frame &frame)
+{
+  return frame.version == RADIO_FRAME_VERSION &&
+         frame.crc == radio_frame_crc((const uint8_t *)&frame, sizeof(frame) - 1);
+}
+
+// Function to Unpack a Frame
+void radio_frame_decode(const radio_frame &frame, controller_variables &controller)
+{
+  // Buttons Without the Retries Bits
+  uint8_t buttons = frame.buttons & RADIO_FRAME_BUTTONS_MASK;
+  controller.button1_reading = (buttons >> 0) & 1;
+  controller.button2_reading = (buttons >> 1) & 1;
+  controller.button3_reading = (buttons >> 2) & 1;
+  controller.button4_reading = (buttons >> 3) & 1;
+  controller.button5_reading = (buttons >> 4) & 1;
+  controller.button6_reading = (buttons >> 5) & 1;
+  controller.X1axis_reading = unpack_analog(frame.analog, 0);
+  controller.Y1axis_reading = unpack_analog(frame.analog, 1);
+  controller.X2axis_reading = unpack_analog(frame.analog, 2);
+  controller.Y2axis_reading = unpack_analog(frame.analog, 3);
+  controller.slider1_reading = unpack_analog(frame.analog, 4);
+  controller.slider2_reading = unpack_analog(frame.analog, 5);
+}
@@ -0,0 +1,368 @@
+// Robot Radio Link
+#include <Arduino.h>
+#include <SPI.h>
+#include <RF24.h>
+#include "radio_link.h"
+#include "packet_ring.h"
+#include "radio_frame.h"
+#include "channel_hopping.h"
+#include "link_manager.h"
+
+// Radio Controller Object
+static RF24 radio(PIN_RADIO_CE, PIN_RADIO_CSN);
+
+// Radios Addresses
+static uint8_t address[][6] = {"Ctrlr", "Robot"};
+
+// Radio Number
+static const bool radio_number = 1;
+
+// Received Packets (Frames Stay in Wire Format Until the Loop Decodes Them)
+typedef struct
+{
+  radio_frame frame;
+  unsigned long received_at;
+  uint8_t pipe;
+} received_packet;
+static packet_ring<received_packet, RADIO_RING_SIZE> ring;
+static radio_link_stats stats;
+static uint8_t next_sequence;
+static bool sequence_synced = false;
+
+// Telemetry Double Buffer (the Loop Fills One While the Other is Loaded into the Radio)
+static telemetry_frame telemetry_buffers[2];
+static volatile uint8_t telemetry_ready = 0;
+
+// Pipe the Controller Transmits On
+const uint8_t CONTROLLER_PIPE = 1;
+
+#if (defined(RADIO_HOPPING) || defined(RADIO_ADAPTIVE_RATE)) && defined(RADIO_IRQ_PIN) && defined(__AVR_ATmega32U4__)
+#include <util/atomic.h>
+#define RADIO_ATOMIC() ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+#else
+#define RADIO_ATOMIC()
+#endif
+
+#ifdef RADIO_HOPPING
+// Channel the Radio is Tuned To
+static uint8_t tuned_channel = HOP_RENDEZVOUS_CHANNEL;
+#endif
+
+#ifdef RADIO_ADAPTIVE_RATE
+// Link Profile the Radio is Set To
+static uint8_t set_profile = LINK_FIXED;
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+#ifdef RADIO_HOPPING
+// Function to Tune the Radio, Only When the Channel Changes
+static void tune(uint8_t channel)
+{
+  if (channel != tuned_channel)
+  {
+    radio.setChannel(channel);
+    tuned_channel = channel;
+  }
+}
+
+// Function to Sample the Received Power Detector of Every Channel and Build the Hop Plan
+static void survey_channels(void (*pet)(void))
+{
+  uint8_t busy[HOP_SURVEY_COUNT];
+  memset(busy, 0, sizeof(busy));
+  for (uint8_t pass = 0; pass < HOP_SURVEY_PASSES; pass++)
+  {
+    if (pet != NULL)
+    {
+      pet();
+    }
+    for (uint8_t i = 0; i < HOP_SURVEY_COUNT; i++)
+    {
+      radio.setChannel(HOP_SURVEY_FIRST + i);
+      radio.startListening();
+      delayMicroseconds(HOP_SURVEY_DWELL_US);
+      if (radio.testRPD())
+      {
+        busy[i]++;
+      }
+      radio.stopListening();
+    }
+  }
+  hopping_begin(busy);
+
+  // Packets Caught While Surveying Were Never Meant to be Read
+  radio.flush_rx();
+  radio.setChannel(HOP_RENDEZVOUS_CHANNEL);
+  tuned_channel = HOP_RENDEZVOUS_CHANNEL;
+}
+#endif
+
+#ifdef RADIO_ADAPTIVE_RATE
+// Function to Switch the Radio to a Link Profile, Only When it Changes
+static void apply_profile(uint8_t profile)
+{
+  if (profile != set_profile)
+  {
+    link_profile settings = link_settings(profile);
+    radio.setDataRate((rf24_datarate_e)settings.data_rate);
+    radio.setPALevel(settings.pa_level);
+    set_profile = profile;
+  }
+}
+#endif
+
+// Function to Load the Latest Telemetry as the Next Acknowledgement Payload
+static void load_ack_payload(void)
+{
+  telemetry_frame telemetry = telemetry_buffers[telemetry_ready];
+#ifdef RADIO_ADAPTIVE_RATE
+  // Link Profile Handshake
+  const link_stats &link = link_statistics();
+  telemetry.link_profile = link.announced;
+  telemetry.link_apply_sequence = link.apply_sequence;
+#else
+  telemetry.link_profile = LINK_FIXED;
+  telemetry.link_apply_sequence = 0;
+#endif
+  uint8_t payload[sizeof(telemetry_frame) + sizeof(hop_plan)];
+  uint8_t size = sizeof(telemetry_frame);
+  memcpy(payload, &telemetry, sizeof(telemetry));
+#ifdef RADIO_HOPPING
+  // Plan Announcements Ride Behind the Telemetry
+  hop_plan plan;
+  if (hopping_announcement(plan))
+  {
+    memcpy(&payload[size], &plan, sizeof(plan));
+    size += sizeof(plan);
+  }
+#endif
+  if (!radio.writeAckPayload(CONTROLLER_PIPE, payload, size))
+  {
+    // TX FIFO Full of Stale Frames, Keeps Only the Newest
+    radio.flush_tx();
+    radio.writeAckPayload(CONTROLLER_PIPE, payload, size);
+  }
+}
+
+// Function to Move Every Packet in the Radio FIFO into the Ring
+static void drain_fifo(void)
+{
+  uint8_t pipe;
+  while (radio.available(&pipe))
+  {
+    uint8_t size = radio.getDynamicPayloadSize();
+    received_packet *slot = ring.reserve();
+    if (slot == NULL || size != sizeof(radio_frame))
+    {
+      // Loop Fell Behind or Foreign Payload, Discards the Packet to Keep the FIFO Flowing
+      uint8_t discarded[32];
+      radio.read(discarded, (size > sizeof(discarded)) ? sizeof(discarded) : size);
+      if (slot == NULL)
+      {
+        stats.overflows++;
+      }
+      else
+      {
+        stats.malformed++;
+      }
+    }
+    else
+    {
+      radio.read(&slot->frame, sizeof(slot->frame));
+      if (!radio_frame_valid(slot->frame))
+      {
+        // Left Unpublished, the Slot is Reused by the Next Packet
+        stats.corrupted++;
+      }
+      else
+      {
+        // Counts the Packets the Controller Sent That Never Arrived, a Jump Backwards (Restarted Controller, Repeated
+        // Packet) Resyncs Instead
+        uint8_t lost = sequence_synced ? (uint8_t)(slot->frame.sequence - next_sequence) : 0;
+        if (lost > RADIO_LOST_MAX)
+        {
+          lost = 0;
+          stats.resyncs++;
+        }
+        stats.lost += lost;
+        next_sequence = slot->frame.sequence + 1;
+        sequence_synced = true;
+
+        slot->received_at = micros();
+#ifdef RADIO_HOPPING
+        tune(hopping_received(slot->frame.sequence, slot->received_at));
+#endif
+#ifdef RADIO_ADAPTIVE_RATE
+        // Strong Signal: Received Power Above -64 dBm
+        bool strong = radio.testRPD();
+        apply_profile(
+            link_received(slot->frame.sequence, lost, radio_frame_retries(slot->frame), strong, slot->received_at));
+#endif
+        slot->pipe = pipe;
+        ring.commit();
+      }
+    }
+
+    // The Acknowledgement Just Sent Used the Loaded Payload
+    load_ack_payload();
+  }
+}
+
+#ifdef RADIO_IRQ_PIN
+// Radio IRQ Handler
+static void radio_interrupt(void)
+{
+  // Clears the Flags Before Draining So a Packet Arriving Meanwhile Raises the Line Again
+  bool tx_ok, tx_fail, rx_ready;
+  radio.whatHappened(tx_ok, tx_fail, rx_ready);
+  drain_fifo();
+}
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Initialize the Radio
+bool radio_link_begin(void (*pet)(void))
+{
+  if (!radio.begin())
+  {
+    return false;
+  }
+
+#ifdef RADIO_ADAPTIVE_RATE
+  // Starts on the Robust Profile, Where the Controller Starts Too
+  link_begin();
+  set_profile = LINK_FIXED;
+  apply_profile(LINK_ROBUST);
+#else
+  // Configure Radio for Maximum Power
+  radio.setPALevel(RF24_PA_MAX);
+#endif
+
+  // Configure Radio Payloads (Dynamic Sizes are Required for Acknowledgement Payloads)
+  radio.enableDynamicPayloads();
+  radio.enableAckPayload();
+
+  // Configure Radio Listening Pipe
+  radio.openWritingPipe(address[radio_number]);
+
+  // Configure Radio Channel Number
+  radio.openReadingPipe(1, address[!radio_number]);
+
+#ifdef RADIO_HOPPING
+  // Surveys the Band Before Listening on the Rendezvous Channel
+  survey_channels(pet);
+#else
+  (void)pet;
+#endif
+
+#ifdef RADIO_IRQ_PIN
+  // Only Received Packets Pull the IRQ Line Low
+  radio.maskIRQ(true, true, false);
+  pinMode(RADIO_IRQ_PIN, INPUT);
+  attachInterrupt(digitalPinToInterrupt(RADIO_IRQ_PIN), radio_interrupt, FALLING);
+#endif
+
+  // Configure Radio to Listen for Incoming Data
+  radio.startListening();
+
+  // Preloads the First Acknowledgement Payload
+  telemetry_buffers[0].version = TELEMETRY_VERSION;
+  telemetry_buffers[1].version = TELEMETRY_VERSION;
+  load_ack_payload();
+  return true;
+}
+
+// Function to Power the Radio Down or Back Up
+void radio_link_power(bool on)
+{
+  if (!on)
+  {
+    // Kept From the IRQ Handler, Which Also Talks to the Radio
+    noInterrupts();
+    radio.stopListening();
+    radio.powerDown();
+    interrupts();
+    return;
+  }
+
+  // Nothing Raises the IRQ Line Before the Radio Listens Again
+  radio.powerUp();
+  radio.startListening();
+
+  // Leaving the Listening Mode Flushed the Loaded Acknowledgement Payload
+  noInterrupts();
+  load_ack_payload();
+  interrupts();
+}
+
+// Function to Take the Newest Received Packet
+bool radio_link_receive(controller_variables &controller, radio_link_packet &received)
+{
+#ifndef RADIO_IRQ_PIN
+  drain_fifo();
+#endif
+
+#if defined(RADIO_HOPPING) || defined(RADIO_ADAPTIVE_RATE)
+  // Keeps Following the Controller Through Lost Packets (the IRQ Handler Also Reconfigures the Radio)
+  RADIO_ATOMIC()
+  {
+    uint32_t now = micros();
+#ifdef RADIO_HOPPING
+    tune(hopping_update(now));
+#endif
+#ifdef RADIO_ADAPTIVE_RATE
+    apply_profile(link_update(now));
+#endif
+  }
+#endif
+
+  received_packet *packet = ring.front();
+  if (packet == NULL)
+  {
+    return false;
+  }
+
+  // Skips to the Newest Packet, Older Sticks Readings Are Already Stale
+  while (ring.count() > 1)
+  {
+    ring.release();
+    stats.superseded++;
+  }
+  packet = ring.front();
+
+  radio_frame_decode(packet->frame, controller);
+  received.pipe = packet->pipe;
+  received.sequence = packet->frame.sequence;
+  received.received_at = packet->received_at;
+  unsigned long latency = micros() - packet->received_at;
+  ring.release();
+
+  stats.received++;
+  stats.latency_us = (latency > 0xFFFF) ? 0xFFFF : latency;
+  if (stats.latency_us > stats.latency_max_us)
+  {
+    stats.latency_max_us = stats.latency_us;
+  }
+  return true;
+}
+
+// Function to Set the Telemetry Frame
+void radio_link_set_telemetry(const telemetry_frame &telemetry)
+{
+  // Fills the Buffer Not in Use and Publishes it with a Single Byte Write
+  uint8_t next = telemetry_ready ^ 1;
+  telemetry_buffers[next] = telemetry;
+  telemetry_buffers[next].version = TELEMETRY_VERSION;
+  PACKET_RING_BARRIER();
+  telemetry_ready = next;
+}
+
+// Function to Read the Reception Statistics
+const radio_link_stats &radio_link_statistics(void)
+{
+  return stats;
+}
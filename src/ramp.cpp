@@ -0,0 +1,138 @@
+// Wheel Duty Ramps
+#include <Arduino.h>
+#include "ramp.h"
+
+// Step Limits of Each Wheel (Q15 Duty Units per Tick)
+typedef struct
+{
+  uint16_t accel_step;
+  uint16_t decel_step;
+  uint8_t coast_ticks;
+} ramp_limits;
+static ramp_limits limits[NUMBER_WHEELS] = {
+    {DUTY_FULL_SCALE, DUTY_FULL_SCALE, 0},
+    {DUTY_FULL_SCALE, DUTY_FULL_SCALE, 0},
+    {DUTY_FULL_SCALE, DUTY_FULL_SCALE, 0},
+    {DUTY_FULL_SCALE, DUTY_FULL_SCALE, 0},
+};
+
+// Ramp State of Each Wheel
+static int16_t current[NUMBER_WHEELS];
+static uint8_t coasting[NUMBER_WHEELS];
+static bool last_forward[NUMBER_WHEELS];
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Convert a Full Scale Time into a Step per Tick
+static uint16_t step_per_tick(uint16_t full_scale_ms, uint32_t tick_us)
+{
+  if (full_scale_ms == 0)
+  {
+    return DUTY_FULL_SCALE;
+  }
+  uint32_t step = ((uint32_t)DUTY_FULL_SCALE * tick_us) / ((uint32_t)full_scale_ms * 1000);
+  return (step == 0) ? 1 : (step > (uint32_t)DUTY_FULL_SCALE) ? DUTY_FULL_SCALE : step;
+}
+
+// Function to Step One Wheel
+static int16_t step_wheel(uint8_t wheel, int16_t target, uint16_t floor)
+{
+  const ramp_limits &limit = limits[wheel];
+  int16_t duty = current[wheel];
+
+  // At Rest: Starts at Once, Unless Reversing Before the Coast Time Ran Out
+  if (duty == 0)
+  {
+    if (coasting[wheel] > 0)
+    {
+      coasting[wheel]--;
+      if (target != 0 && (target > 0) != last_forward[wheel])
+      {
+        return 0;
+      }
+    }
+    if (target == 0)
+    {
+      return 0;
+    }
+    uint16_t magnitude = (target < 0) ? -target : target;
+    magnitude = (magnitude < floor) ? magnitude : floor;
+    return (target < 0) ? -(int16_t)magnitude : (int16_t)magnitude;
+  }
+
+  // Moving: Heads to the Target, or to Rest First When it Lies the Other Way
+  const bool forward = duty > 0;
+  uint16_t magnitude = forward ? duty : -duty;
+  uint16_t goal = 0;
+  if (target != 0 && (target > 0) == forward)
+  {
+    goal = (target < 0) ? -target : target;
+  }
+  if (goal > magnitude)
+  {
+    uint16_t step = goal - magnitude;
+    magnitude += (step < limit.accel_step) ? step : limit.accel_step;
+  }
+  else
+  {
+    uint16_t step = magnitude - goal;
+    magnitude -= (step < limit.decel_step) ? step : limit.decel_step;
+
+    // Below the Floor the Wheel No Longer Turns
+    if (goal == 0 && magnitude < floor)
+    {
+      magnitude = 0;
+    }
+  }
+
+  if (magnitude == 0)
+  {
+    coasting[wheel] = limit.coast_ticks;
+    last_forward[wheel] = forward;
+    return 0;
+  }
+  return forward ? (int16_t)magnitude : -(int16_t)magnitude;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Configure the Ramp of a Wheel
+void ramp_configure(uint8_t wheel, const ramp_profile &profile, uint32_t tick_us)
+{
+  if (wheel >= NUMBER_WHEELS)
+  {
+    return;
+  }
+  limits[wheel].accel_step = step_per_tick(profile.accel_ms, tick_us);
+  limits[wheel].decel_step = step_per_tick(profile.decel_ms, tick_us);
+  uint32_t coast = ((uint32_t)profile.coast_ms * 1000 + tick_us - 1) / tick_us;
+  limits[wheel].coast_ticks = (coast > 255) ? 255 : coast;
+}
+
+// Function to Step the Ramps
+void ramp_update(const drive_command &target, int16_t floor, drive_command &output)
+{
+  const uint16_t magnitude_floor = (floor < 0) ? 0 : floor;
+  for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+  {
+    current[i] = step_wheel(i, target.duty[i], magnitude_floor);
+    output.duty[i] = current[i];
+  }
+}
+
+// Function to Stop the Ramps
+void ramp_reset(void)
+{
+  for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+  {
+    // Wheels Still Spinning Coast Before Any Reversal
+    if (current[i] != 0)
+    {
+      last_forward[i] = current[i] > 0;
+      coasting[i] = limits[i].coast_ticks;
+    }
+    current[i] = 0;
+  }
+}
@@ -0,0 +1,68 @@
+// Fixed Rate Cooperative Scheduler
+#include <Arduino.h>
+#include "scheduler.h"
+
+// Function to Start the Scheduler
+void scheduler_begin(scheduler_task *tasks, uint8_t count)
+{
+  uint32_t now = micros();
+  for (uint8_t i = 0; i < count; i++)
+  {
+    tasks[i].next_release = now;
+  }
+}
+
+// Function to Run the Tasks Due
+uint32_t scheduler_run(scheduler_task *tasks, uint8_t count)
+{
+  for (uint8_t i = 0; i < count; i++)
+  {
+    scheduler_task &task = tasks[i];
+    uint32_t start = micros();
+    if ((int32_t)(start - task.next_release) < 0)
+    {
+      continue;
+    }
+
+    // Keeps the Release Grid, Skipping the Periods Already Missed
+    task.next_release += task.period_us;
+    if ((int32_t)(start - task.next_release) >= 0)
+    {
+      uint32_t behind = (start - task.next_release) / task.period_us + 1;
+      uint32_t missed = task.missed + behind;
+      task.missed = (missed > 0xFFFF) ? 0xFFFF : missed;
+      task.next_release += behind * task.period_us;
+    }
+
+    task.run();
+
+    // Run Time Statistics
+    uint32_t elapsed = micros() - start;
+    uint16_t run_us = (elapsed > 0xFFFF) ? 0xFFFF : elapsed;
+    if (run_us > task.max_us)
+    {
+      task.max_us = run_us;
+    }
+    if (run_us > task.budget_us && task.overruns < 0xFFFF)
+    {
+      task.overruns++;
+    }
+  }
+
+  // Time Left Before the Earliest Release (None if a Task Fell Due Meanwhile)
+  uint32_t now = micros();
+  uint32_t idle = 0xFFFFFFFF;
+  for (uint8_t i = 0; i < count; i++)
+  {
+    int32_t left = (int32_t)(tasks[i].next_release - now);
+    if (left <= 0)
+    {
+      return 0;
+    }
+    if ((uint32_t)left < idle)
+    {
+      idle = left;
+    }
+  }
+  return idle;
+}
@@ -0,0 +1,135 @@
+// Closed Loop Wheel Speed Control
+#include <Arduino.h>
+#include "speed_control.h"
+
+// Configuration
+static uint8_t encoded = 0;
+static speed_gains gains = SPEED_GAINS_OPEN;
+static uint32_t edges_scale = 0;
+
+// Speed Measurement Windows
+static uint8_t window[NUMBER_WHEELS][SPEED_WINDOW];
+static uint16_t window_sum[NUMBER_WHEELS];
+static uint8_t window_index = 0;
+static bool discard = true;
+
+// Controllers State
+static int32_t integral[NUMBER_WHEELS];
+static int16_t last_error[NUMBER_WHEELS];
+static bool last_forward[NUMBER_WHEELS];
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Clear the Controller of One Wheel
+static void clear_wheel(uint8_t wheel)
+{
+  integral[wheel] = 0;
+  last_error[wheel] = 0;
+}
+
+// Function to Step the Controller of One Wheel
+static int16_t step_wheel(uint8_t wheel, int16_t target)
+{
+  if (target == 0)
+  {
+    clear_wheel(wheel);
+    return 0;
+  }
+
+  // Measured Speed Along the Target Direction (Q15), Negative While Still Turning the Other Way
+  const bool forward = target > 0;
+  int32_t goal = forward ? target : -target;
+  int32_t measured = ((uint32_t)window_sum[wheel] * edges_scale) >> 8;
+  measured = (measured > DUTY_FULL_SCALE) ? DUTY_FULL_SCALE : measured;
+  if (forward != last_forward[wheel])
+  {
+    measured = -measured;
+  }
+  int32_t error = goal - measured;
+
+  // Integral Limited to Half the Duty Scale (Q8)
+  int32_t step = (int32_t)gains.ki * error;
+  integral[wheel] += step;
+  integral[wheel] = constrain(integral[wheel], -((int32_t)SPEED_INTEGRAL_LIMIT << 8),
+                              ((int32_t)SPEED_INTEGRAL_LIMIT << 8));
+
+  // Feed Forward Plus Correction
+  int32_t output = goal + (((int32_t)gains.kp * error + integral[wheel] +
+                            (int32_t)gains.kd * (error - last_error[wheel])) >> 8);
+  last_error[wheel] = error;
+
+  // Saturation Stops the Integral Growing Further the Same Way
+  if (output > DUTY_FULL_SCALE || output < 0)
+  {
+    if ((output > DUTY_FULL_SCALE) == (step > 0))
+    {
+      integral[wheel] -= step;
+    }
+    output = (output < 0) ? 0 : DUTY_FULL_SCALE;
+  }
+
+  if (output > 0)
+  {
+    last_forward[wheel] = forward;
+  }
+  return forward ? (int16_t)output : -(int16_t)output;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Start the Controllers
+void speed_control_begin(uint8_t mask, uint32_t tick_us)
+{
+  encoded = mask;
+
+  // Edges per Window at Full Speed, and the Q8 Factor Taking Window Sums to Q15 Speeds
+  uint32_t full_window = ((uint32_t)SPEED_FULL_SCALE_HZ * (tick_us / 10) * SPEED_WINDOW) / 100000;
+  edges_scale = ((uint32_t)DUTY_FULL_SCALE << 8) / ((full_window == 0) ? 1 : full_window);
+  speed_control_reset();
+}
+
+// Function to Set the Gains
+void speed_control_configure(const speed_gains &values)
+{
+  gains = values;
+  for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+  {
+    clear_wheel(i);
+  }
+}
+
+// Function to Step the Controllers
+void speed_control_update(const drive_command &target, const uint8_t edges[NUMBER_WHEELS], drive_command &output)
+{
+  const bool open = (gains.kp | gains.ki | gains.kd) == 0;
+  for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+  {
+    // Edges Counted While Stopped Belong to No Tick
+    uint8_t count = discard ? 0 : edges[i];
+    window_sum[i] += count - window[i][window_index];
+    window[i][window_index] = count;
+
+    int16_t duty = target.duty[i];
+    output.duty[i] = (open || (encoded & (1 << i)) == 0) ? duty : step_wheel(i, duty);
+  }
+  window_index = (window_index + 1) % SPEED_WINDOW;
+  discard = false;
+}
+
+// Function to Clear the Controllers
+void speed_control_reset(void)
+{
+  for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+  {
+    clear_wheel(i);
+    window_sum[i] = 0;
+    for (uint8_t j = 0; j < SPEED_WINDOW; j++)
+    {
+      window[i][j] = 0;
+    }
+  }
+  window_index = 0;
+  discard = true;
+}
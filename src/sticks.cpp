@@ -0,0 +1,395 @@
+// Calibrated Stick Response
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "sticks.h"
+#include "mixer.h"
+#include "radio_frame.h"
+
+// Expo Curve Shape (Share of the Cubic Term) and Table Spacing (Q8 Deflection Units per Entry)
+constexpr float EXPO_SHARE = 0.6;
+const uint8_t EXPO_STEP_SHIFT = 4;
+const uint8_t EXPO_ENTRIES = (DEFLECTION_FULL_SCALE >> EXPO_STEP_SHIFT) + 1;
+
+// The Defaults Must Pass the Checks Stored Calibrations Do
+static_assert(AXIS_DEFAULT_DEADBAND <= STICKS_DEADBAND_MAX, "the default deadband must stay within the maximum");
+
+// Calibration Measurement Phases
+enum calibration_phase
+{
+  PHASE_IDLE = 0,
+  PHASE_CENTERING,
+  PHASE_SWEEPING
+};
+
+// Stored Calibration
+typedef struct __attribute__((packed))
+{
+  uint8_t version;
+  axis_calibration axes[NUMBER_AXES];
+  uint8_t crc;
+} stored_calibration;
+
+// Deadband Edges and Q10 Reciprocals of the Travel Past Each Edge
+typedef struct
+{
+  uint16_t dead_low;
+  uint16_t dead_high;
+  uint32_t scale_low;
+  uint32_t scale_high;
+} axis_scale;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Expo Table Builder (Evaluated at Compile Time)
+constexpr uint16_t expo(uint8_t index)
+{
+  return (uint16_t)(DEFLECTION_FULL_SCALE *
+                        ((1.0 - EXPO_SHARE) * (index / 16.0) + EXPO_SHARE * (index / 16.0) * (index / 16.0) *
+                                                                   (index / 16.0)) +
+                    0.5);
+}
+#define EXPO_ENTRIES_4(i) expo(i), expo(i + 1), expo(i + 2), expo(i + 3)
+static const uint16_t EXPO_CURVE[EXPO_ENTRIES] PROGMEM = {
+    EXPO_ENTRIES_4(0), EXPO_ENTRIES_4(4), EXPO_ENTRIES_4(8), EXPO_ENTRIES_4(12), expo(16)};
+
+// Calibration in Use
+static axis_calibration calibration[NUMBER_AXES];
+static axis_scale scales[NUMBER_AXES];
+static uint8_t curves[NUMBER_AXES];
+static uint8_t source = STICKS_DEFAULT;
+
+// Calibration Measurement
+static uint8_t phase = PHASE_IDLE;
+static uint8_t rest_packets = 0;
+static bool holding = false;
+static unsigned long phase_start = 0;
+static uint32_t sums[NUMBER_AXES];
+static uint16_t counts;
+static uint16_t lows[NUMBER_AXES];
+static uint16_t highs[NUMBER_AXES];
+static axis_calibration measured[NUMBER_AXES];
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Read the Four Axes of a Packet
+static void axis_readings(const controller_variables &controller, uint16_t readings[NUMBER_AXES])
+{
+  readings[AXIS_X1] = controller.X1axis_reading;
+  readings[AXIS_Y1] = controller.Y1axis_reading;
+  readings[AXIS_X2] = controller.X2axis_reading;
+  readings[AXIS_Y2] = controller.Y2axis_reading;
+}
+
+// Function to Check an Axis Calibration Leaves Travel on Both Sides of the Deadband
+static bool axis_valid(const axis_calibration &axis)
+{
+  return axis.deadband <= STICKS_DEADBAND_MAX && axis.center >= axis.deadband &&
+         axis.low < axis.center - axis.deadband && axis.center + axis.deadband < axis.high &&
+         axis.high <= AXIS_READING_MAX;
+}
+
+// Function to Check a Reading is Close Enough to the Middle to be a Stick at Rest
+static bool near_middle(uint16_t reading)
+{
+  uint16_t distance =
+      (reading > AXIS_READING_MAX / 2) ? reading - AXIS_READING_MAX / 2 : AXIS_READING_MAX / 2 - reading;
+  return distance <= STICKS_REST_TOLERANCE;
+}
+
+// Function to Put an Axis Calibration in Use (the Only Divisions, Rounded Up as the Fixed Scales Were)
+static void apply_axis(uint8_t axis, const axis_calibration &values)
+{
+  calibration[axis] = values;
+  axis_scale &scale = scales[axis];
+  scale.dead_low = values.center - values.deadband;
+  scale.dead_high = values.center + values.deadband;
+  uint16_t travel_low = scale.dead_low - values.low;
+  uint16_t travel_high = values.high - scale.dead_high;
+  scale.scale_low = ((uint32_t)DEFLECTION_FULL_SCALE * 1024 + travel_low - 1) / travel_low;
+  scale.scale_high = ((uint32_t)DEFLECTION_FULL_SCALE * 1024 + travel_high - 1) / travel_high;
+}
+
+// Function to Put the Default Calibration in Use
+static void apply_defaults(void)
+{
+  const axis_calibration defaults = {0, AXIS_DEFAULT_CENTER, AXIS_READING_MAX, AXIS_DEFAULT_DEADBAND};
+  for (uint8_t i = 0; i < NUMBER_AXES; i++)
+  {
+    apply_axis(i, defaults);
+  }
+  source = STICKS_DEFAULT;
+}
+
+// Function to Load the Stored Calibration, False if None is Valid
+static bool load_stored(void)
+{
+  stored_calibration stored;
+  EEPROM.get(STICKS_EEPROM_ADDRESS, stored);
+  if (stored.version != STICKS_EEPROM_VERSION ||
+      stored.crc != radio_frame_crc((const uint8_t *)&stored, sizeof(stored) - 1))
+  {
+    return false;
+  }
+  for (uint8_t i = 0; i < NUMBER_AXES; i++)
+  {
+    if (!axis_valid(stored.axes[i]))
+    {
+      return false;
+    }
+  }
+  for (uint8_t i = 0; i < NUMBER_AXES; i++)
+  {
+    apply_axis(i, stored.axes[i]);
+  }
+  source = STICKS_STORED;
+  return true;
+}
+
+// Function to Check Every Reading is Inside the Deadband of the Calibration in Use
+static bool inside_deadbands(const uint16_t readings[NUMBER_AXES])
+{
+  for (uint8_t i = 0; i < NUMBER_AXES; i++)
+  {
+    if (readings[i] < scales[i].dead_low || readings[i] > scales[i].dead_high)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Function to Start Measuring the Readings of a Phase
+static void start_phase(uint8_t next, unsigned long now)
+{
+  phase = next;
+  phase_start = now;
+  counts = 0;
+  for (uint8_t i = 0; i < NUMBER_AXES; i++)
+  {
+    sums[i] = 0;
+    lows[i] = AXIS_READING_MAX;
+    highs[i] = 0;
+  }
+}
+
+// Function to Accumulate One Packet's Readings
+static void accumulate(const uint16_t readings[NUMBER_AXES])
+{
+  counts++;
+  for (uint8_t i = 0; i < NUMBER_AXES; i++)
+  {
+    sums[i] += readings[i];
+    lows[i] = (readings[i] < lows[i]) ? readings[i] : lows[i];
+    highs[i] = (readings[i] > highs[i]) ? readings[i] : highs[i];
+  }
+}
+
+// Function to Build the Calibration of an Axis at Rest (Ends Stay at the Full Travel), False if Not at Rest
+static bool rest_axis(uint8_t axis, axis_calibration &values)
+{
+  values.low = 0;
+  values.high = AXIS_READING_MAX;
+  values.center = (sums[axis] + counts / 2) / counts;
+  uint16_t jitter = highs[axis] - values.center;
+  jitter = (values.center - lows[axis] > jitter) ? values.center - lows[axis] : jitter;
+  if (!near_middle(values.center) || jitter > STICKS_JITTER_MAX)
+  {
+    return false;
+  }
+  jitter += STICKS_DEADBAND_MARGIN;
+  values.deadband = (jitter < STICKS_DEADBAND_MIN) ? STICKS_DEADBAND_MIN : jitter;
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Start the Sticks
+void sticks_begin(const uint8_t axis_curves[NUMBER_AXES])
+{
+  for (uint8_t i = 0; i < NUMBER_AXES; i++)
+  {
+    curves[i] = axis_curves[i];
+  }
+  phase = PHASE_IDLE;
+  holding = false;
+  counts = 0;
+  if (!load_stored())
+  {
+    apply_defaults();
+  }
+
+  // Only Measures the Sticks at Rest Without a Stored Calibration
+  rest_packets = (source == STICKS_DEFAULT) ? STICKS_REST_PACKETS : 0;
+  start_phase(PHASE_IDLE, 0);
+}
+
+// Function to Feed a Packet to the Calibration
+bool sticks_update(const controller_variables &controller, uint8_t buttons, unsigned long now)
+{
+  uint16_t readings[NUMBER_AXES];
+  axis_readings(controller, readings);
+
+  // Sticks at Rest Over the First Packets
+  if (rest_packets > 0 && phase == PHASE_IDLE)
+  {
+    for (uint8_t i = 0; i < NUMBER_AXES; i++)
+    {
+      if (!near_middle(readings[i]))
+      {
+        rest_packets = 0;
+        break;
+      }
+    }
+    if (rest_packets > 0)
+    {
+      accumulate(readings);
+      if (--rest_packets == 0)
+      {
+        // Too Much Jitter on Any Axis Keeps the Defaults
+        axis_calibration rest[NUMBER_AXES];
+        bool valid = true;
+        for (uint8_t i = 0; i < NUMBER_AXES; i++)
+        {
+          valid = rest_axis(i, rest[i]) && valid;
+        }
+        if (valid)
+        {
+          for (uint8_t i = 0; i < NUMBER_AXES; i++)
+          {
+            apply_axis(i, rest[i]);
+          }
+          source = STICKS_REST;
+        }
+      }
+    }
+  }
+
+  // Holding the Buttons With the Sticks Inside Their Deadbands (the Robot Stopped) Starts a Calibration
+  bool held = (buttons & STICKS_CALIBRATION_BUTTONS) == STICKS_CALIBRATION_BUTTONS && inside_deadbands(readings);
+  if (phase == PHASE_IDLE)
+  {
+    if (!held)
+    {
+      holding = false;
+    }
+    else if (!holding)
+    {
+      holding = true;
+      phase_start = now;
+    }
+    else if ((now - phase_start) >= STICKS_HOLD_MS)
+    {
+      holding = false;
+      rest_packets = 0;
+      start_phase(PHASE_CENTERING, now);
+    }
+    return false;
+  }
+
+  // Centers and Jitter With the Sticks Left at Rest
+  accumulate(readings);
+  if (phase == PHASE_CENTERING)
+  {
+    if ((now - phase_start) >= STICKS_CENTER_MS)
+    {
+      // Sticks Not Left at Rest Call the Calibration Off, Keeping the One in Use
+      for (uint8_t i = 0; i < NUMBER_AXES; i++)
+      {
+        if (!rest_axis(i, measured[i]))
+        {
+          phase = PHASE_IDLE;
+          return false;
+        }
+      }
+      start_phase(PHASE_SWEEPING, now);
+    }
+    return true;
+  }
+
+  // Ends Reached While Sweeping, the Full Travel Where a Side Was Not Swept Far Enough
+  if ((now - phase_start) < STICKS_SWEEP_MS)
+  {
+    return true;
+  }
+  stored_calibration stored;
+  stored.version = STICKS_EEPROM_VERSION;
+  for (uint8_t i = 0; i < NUMBER_AXES; i++)
+  {
+    axis_calibration values = measured[i];
+    values.low = (values.center >= lows[i] + STICKS_TRAVEL_MIN) ? lows[i] : 0;
+    values.high = (highs[i] >= values.center + STICKS_TRAVEL_MIN) ? highs[i] : AXIS_READING_MAX;
+    stored.axes[i] = values;
+  }
+  stored.crc = radio_frame_crc((const uint8_t *)&stored, sizeof(stored) - 1);
+
+  // Keeps the Calibration in Use if the New One Can Not Work
+  phase = PHASE_IDLE;
+  for (uint8_t i = 0; i < NUMBER_AXES; i++)
+  {
+    if (!axis_valid(stored.axes[i]))
+    {
+      return false;
+    }
+  }
+  EEPROM.put(STICKS_EEPROM_ADDRESS, stored);
+  for (uint8_t i = 0; i < NUMBER_AXES; i++)
+  {
+    apply_axis(i, stored.axes[i]);
+  }
+  source = STICKS_STORED;
+  return false;
+}
+
+// Function to Read the Calibration Source
+uint8_t sticks_source(void)
+{
+  return source;
+}
+
+// Function to Read the Calibration of an Axis
+const axis_calibration &sticks_calibration(uint8_t axis)
+{
+  return calibration[axis];
+}
+
+// Function to Convert a Stick Reading into a Signed Deflection
+int16_t stick_deflection(uint8_t axis, uint16_t reading)
+{
+  if (phase != PHASE_IDLE)
+  {
+    return 0;
+  }
+
+  const axis_scale &scale = scales[axis];
+  uint32_t magnitude;
+  if (reading > scale.dead_high)
+  {
+    magnitude = ((uint32_t)(reading - scale.dead_high) * scale.scale_high) >> 10;
+  }
+  else if (reading < scale.dead_low)
+  {
+    magnitude = ((uint32_t)(scale.dead_low - reading) * scale.scale_low) >> 10;
+  }
+  else
+  {
+    return 0;
+  }
+  magnitude = (magnitude > (uint32_t)DEFLECTION_FULL_SCALE) ? DEFLECTION_FULL_SCALE : magnitude;
+
+  // Expo Curve, Interpolated Between Entries
+  if (curves[axis] == CURVE_EXPO)
+  {
+    uint8_t index = magnitude >> EXPO_STEP_SHIFT;
+    uint16_t low = pgm_read_word(&EXPO_CURVE[index]);
+    if (index < EXPO_ENTRIES - 1)
+    {
+      uint16_t high = pgm_read_word(&EXPO_CURVE[index + 1]);
+      low += ((uint16_t)(high - low) * (magnitude & ((1 << EXPO_STEP_SHIFT) - 1))) >> EXPO_STEP_SHIFT;
+    }
+    magnitude = low;
+  }
+  return (reading < scale.dead_low) ? -(int16_t)magnitude : (int16_t)magnitude;
+}
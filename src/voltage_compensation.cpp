@@ -0,0 +1,96 @@
+// Battery Voltage Compensation of the Wheel Duties
+#include <Arduino.h>
+#include "voltage_compensation.h"
+
+// Lowest Table Entry (Raw ADC Counts and Filtered Reading)
+static const uint16_t TABLE_FIRST = battery_counts(COMPENSATION_TABLE_VOLTAGE) >> BATTERY_FILTER_SHIFT;
+static const uint16_t TABLE_FIRST_READING = TABLE_FIRST << BATTERY_FILTER_SHIFT;
+static const uint8_t ENTRY_SHIFT = COMPENSATION_TABLE_STEP_SHIFT + BATTERY_FILTER_SHIFT;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Table Builders (Evaluated at Compile Time)
+constexpr float entry_volts(uint8_t index)
+{
+  return (TABLE_FIRST + ((uint16_t)index << COMPENSATION_TABLE_STEP_SHIFT)) * (BATTERY_FULL_SCALE_MV / 1024000.0);
+}
+
+constexpr uint16_t reciprocal(float motor_volts)
+{
+  return (motor_volts * COMPENSATION_FACTOR_MAX <= (COMPENSATION_NOMINAL_VOLTAGE - COMPENSATION_BRIDGE_DROP) *
+                                                        COMPENSATION_FACTOR_UNITY)
+             ? COMPENSATION_FACTOR_MAX
+             : (uint16_t)((COMPENSATION_NOMINAL_VOLTAGE - COMPENSATION_BRIDGE_DROP) / motor_volts *
+                              COMPENSATION_FACTOR_UNITY +
+                          0.5);
+}
+
+// Scale Factor of Each Table Entry
+#define COMPENSATION_ENTRY(i) reciprocal(entry_volts(i) - COMPENSATION_BRIDGE_DROP)
+#define COMPENSATION_ENTRIES_4(i) COMPENSATION_ENTRY(i), COMPENSATION_ENTRY(i + 1), COMPENSATION_ENTRY(i + 2), \
+                                  COMPENSATION_ENTRY(i + 3)
+#define COMPENSATION_ENTRIES_16(i) COMPENSATION_ENTRIES_4(i), COMPENSATION_ENTRIES_4(i + 4), \
+                                   COMPENSATION_ENTRIES_4(i + 8), COMPENSATION_ENTRIES_4(i + 12)
+static const uint16_t FACTORS[COMPENSATION_TABLE_SIZE] PROGMEM = {
+    COMPENSATION_ENTRIES_16(0), COMPENSATION_ENTRIES_16(16), COMPENSATION_ENTRIES_16(32), COMPENSATION_ENTRIES_16(48)};
+
+// Smoothed Reading and its Factor
+static uint16_t smoothed = 0;
+static uint16_t factor = COMPENSATION_FACTOR_UNITY;
+
+//----------------------------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------------------------
+
+// Function to Look Up the Factor of a Reading
+static uint16_t lookup(uint16_t reading)
+{
+  if (reading <= TABLE_FIRST_READING)
+  {
+    return pgm_read_word(&FACTORS[0]);
+  }
+  uint16_t offset = reading - TABLE_FIRST_READING;
+  uint16_t index = offset >> ENTRY_SHIFT;
+  if (index >= COMPENSATION_TABLE_SIZE - 1)
+  {
+    return pgm_read_word(&FACTORS[COMPENSATION_TABLE_SIZE - 1]);
+  }
+
+  // Interpolates Between the Two Entries Around the Reading (Factors Fall as the Voltage Rises)
+  uint16_t low = pgm_read_word(&FACTORS[index]);
+  uint16_t high = pgm_read_word(&FACTORS[index + 1]);
+  uint16_t fraction = offset & ((1 << ENTRY_SHIFT) - 1);
+  return low - (uint16_t)(((uint32_t)(low - high) * fraction) >> ENTRY_SHIFT);
+}
+
+// Function to Start the Compensation
+void compensation_begin(uint16_t reading)
+{
+  smoothed = reading;
+  factor = lookup(smoothed);
+}
+
+// Function to Feed a Battery Reading
+void compensation_update(uint16_t reading)
+{
+  smoothed = (int16_t)smoothed + (((int16_t)reading - (int16_t)smoothed) >> COMPENSATION_FILTER_SHIFT);
+  factor = lookup(smoothed);
+}
+
+// Function to Read the Scale Factor
+uint16_t compensation_factor(void)
+{
+  return factor;
+}
+
+// Function to Scale the Wheel Duties
+void compensation_apply(const drive_command &input, drive_command &output)
+{
+  for (uint8_t i = 0; i < NUMBER_WHEELS; i++)
+  {
+    int16_t duty = input.duty[i];
+    uint32_t magnitude = ((uint32_t)((duty < 0) ? -duty : duty) * factor) >> COMPENSATION_FACTOR_SHIFT;
+    magnitude = (magnitude > (uint32_t)DUTY_FULL_SCALE) ? DUTY_FULL_SCALE : magnitude;
+    output.duty[i] = (duty < 0) ? -(int16_t)magnitude : (int16_t)magnitude;
+  }
+}